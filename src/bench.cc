@@ -0,0 +1,327 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <random>
+#include <string>
+
+#include "s21_delta_stepping.hpp"
+#include "s21_graph_algorithms.hpp"
+
+namespace {
+using Matrix = std::vector<std::vector<int>>;
+
+// Synthetic families; the benchmark argument selecting one is its index.
+enum GraphKind { kRandom, kGrid, kScaleFree, kEuclidean };
+
+const char *const kKindNames[] = {"random", "grid", "scale_free",
+                                  "euclidean"};
+
+// Sizes in vertices. The adjacency matrix is dense, so 100k vertices would
+// take 40 GB; the largest size keeps a matrix around 64 MB.
+const std::vector<int64_t> kSizes = {100, 1000, 4000};
+const std::vector<int64_t> kCubicSizes = {100, 400};
+const std::vector<int64_t> kKinds = {kRandom, kGrid, kScaleFree, kEuclidean};
+
+// Every generator is seeded with a fixed value, so a given kind and size is
+// the same graph on every run and every machine.
+const unsigned kSeed = 21;
+
+void Connect(Matrix &matrix, size_t v, size_t u, int weight) {
+  matrix[v][u] = matrix[u][v] = weight;
+}
+
+// G(n, p) over a path through all vertices in random order, with an
+// expected degree of 8. The path keeps the graph connected, so the tour and
+// vertex-to-vertex benchmarks never hit the unreachable shortcut.
+Matrix GenerateRandom(size_t size, bool weighted) {
+  Matrix matrix(size, std::vector<int>(size, 0));
+  std::mt19937 eng(kSeed);
+  std::uniform_int_distribution<int> distr(1, 9);
+  std::vector<size_t> path(size);
+  std::iota(path.begin(), path.end(), 0);
+  std::shuffle(path.begin(), path.end(), eng);
+  for (size_t i = 1; i < size; i++)
+    Connect(matrix, path[i - 1], path[i], weighted ? distr(eng) : 1);
+  std::bernoulli_distribution edge(std::min(1.0, 6.0 / size));
+  for (size_t v = 0; v < size; v++)
+    for (size_t u = v + 1; u < size; u++)
+      if (edge(eng)) Connect(matrix, v, u, weighted ? distr(eng) : 1);
+  return matrix;
+}
+
+// Road-like side x side grid written with shuffled vertex numbers, so that
+// grid neighbours end up far apart in the adjacency matrix.
+Matrix GenerateGrid(size_t size, bool weighted) {
+  size_t side = std::lround(std::sqrt(size));
+  size = side * side;
+  std::vector<size_t> id(size);
+  std::iota(id.begin(), id.end(), 0);
+  std::mt19937 eng(kSeed);
+  std::shuffle(id.begin(), id.end(), eng);
+  std::uniform_int_distribution<int> distr(1, 9);
+  Matrix matrix(size, std::vector<int>(size, 0));
+  for (size_t r = 0; r < side; r++)
+    for (size_t c = 0; c < side; c++) {
+      size_t v = id[r * side + c];
+      if (c + 1 < side)
+        Connect(matrix, v, id[r * side + c + 1], weighted ? distr(eng) : 1);
+      if (r + 1 < side)
+        Connect(matrix, v, id[(r + 1) * side + c], weighted ? distr(eng) : 1);
+    }
+  return matrix;
+}
+
+// Barabasi-Albert preferential attachment: every new vertex links to two
+// existing ones picked with probability proportional to their degree.
+Matrix GenerateScaleFree(size_t size, bool weighted) {
+  Matrix matrix(size, std::vector<int>(size, 0));
+  std::mt19937 eng(kSeed);
+  std::uniform_int_distribution<int> distr(1, 9);
+  std::vector<size_t> ends = {0, 1};
+  Connect(matrix, 0, 1, weighted ? distr(eng) : 1);
+  for (size_t v = 2; v < size; v++) {
+    for (int link = 0; link < 2; link++) {
+      size_t u = ends[std::uniform_int_distribution<size_t>(
+          0, ends.size() - 1)(eng)];
+      if (matrix[v][u] != 0) continue;
+      Connect(matrix, v, u, weighted ? distr(eng) : 1);
+      ends.push_back(u);
+      ends.push_back(v);
+    }
+  }
+  return matrix;
+}
+
+// Complete graph on random points of a 1000 x 1000 square; weights are the
+// truncated Euclidean distances plus one, so none is zero.
+Matrix GenerateEuclidean(size_t size, bool) {
+  std::mt19937 eng(kSeed);
+  std::uniform_real_distribution<double> distr(0, 1000);
+  std::vector<std::pair<double, double>> points(size);
+  for (std::pair<double, double> &point : points)
+    point = {distr(eng), distr(eng)};
+  Matrix matrix(size, std::vector<int>(size, 0));
+  for (size_t v = 0; v < size; v++)
+    for (size_t u = v + 1; u < size; u++)
+      Connect(matrix, v, u,
+              1 + static_cast<int>(
+                      std::hypot(points[v].first - points[u].first,
+                                 points[v].second - points[u].second)));
+  return matrix;
+}
+
+// Writes the graph once per run and returns the file name.
+std::string GetGraphFile(int64_t kind, int64_t size, bool weighted = true) {
+  static std::map<std::string, std::string> written;
+  std::string name = std::string(kKindNames[kind]) + "_" +
+                     std::to_string(size) + (weighted ? "_weighted" : "");
+  std::string &filename = written[name];
+  if (!filename.empty()) return filename;
+  Matrix (*generators[])(size_t, bool) = {GenerateRandom, GenerateGrid,
+                                          GenerateScaleFree, GenerateEuclidean};
+  Matrix matrix = generators[kind](size, weighted);
+  filename = "/tmp/s21_bench_" + name + ".txt";
+  std::ofstream file(filename);
+  file << matrix.size() << '\n';
+  for (const std::vector<int> &row : matrix) {
+    for (int weight : row) file << weight << ' ';
+    file << '\n';
+  }
+  return filename;
+}
+
+s21::Graph LoadGraph(int64_t kind, int64_t size, bool weighted = true) {
+  s21::Graph graph;
+  graph.LoadGraphFromFile(GetGraphFile(kind, size, weighted));
+  return graph;
+}
+
+void SetLabel(benchmark::State &state) {
+  state.SetLabel(kKindNames[state.range(0)]);
+}
+
+void BM_LoadGraphFromFile(benchmark::State &state) {
+  std::string filename = GetGraphFile(state.range(0), state.range(1));
+  for (auto _ : state) {
+    s21::Graph graph;
+    graph.LoadGraphFromFile(filename);
+    benchmark::DoNotOptimize(graph.GetVertices());
+  }
+  SetLabel(state);
+}
+
+void BM_DepthFirstSearch(benchmark::State &state) {
+  s21::Graph graph = LoadGraph(state.range(0), state.range(1), false);
+  s21::GraphAlgorithms algorithms;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(algorithms.DepthFirstSearch(graph, 1));
+  SetLabel(state);
+}
+
+void BM_BreadthFirstSearch(benchmark::State &state) {
+  s21::Graph graph = LoadGraph(state.range(0), state.range(1), false);
+  s21::GraphAlgorithms algorithms;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(algorithms.BreadthFirstSearch(graph, 1));
+  SetLabel(state);
+}
+
+void BM_HopDistancesFromVertices(benchmark::State &state) {
+  s21::Graph graph = LoadGraph(state.range(0), state.range(1), false);
+  s21::GraphAlgorithms algorithms;
+  std::vector<size_t> starts(64);
+  for (size_t i = 0; i < starts.size(); i++)
+    starts[i] = 1 + i * graph.GetVertices() / starts.size();
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+        algorithms.GetHopDistancesFromVertices(graph, starts));
+  SetLabel(state);
+}
+
+void BM_ShortestPathBetweenVertices(benchmark::State &state) {
+  s21::Graph graph = LoadGraph(state.range(0), state.range(1));
+  s21::GraphAlgorithms algorithms;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(algorithms.GetShortestPathBetweenVertices(
+        graph, 1, graph.GetVertices()));
+  SetLabel(state);
+}
+
+void BM_ShortestPathsFromVertex(benchmark::State &state) {
+  s21::Graph graph = LoadGraph(state.range(0), state.range(1));
+  s21::GraphAlgorithms algorithms;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(algorithms.GetShortestPathsFromVertex(graph, 1));
+  SetLabel(state);
+}
+
+void BM_ShortestPathsBetweenPairs(benchmark::State &state) {
+  s21::Graph graph = LoadGraph(state.range(0), state.range(1));
+  s21::GraphAlgorithms algorithms;
+  std::mt19937 eng(kSeed);
+  std::uniform_int_distribution<size_t> distr(1, graph.GetVertices());
+  std::vector<std::pair<size_t, size_t>> pairs(256);
+  for (std::pair<size_t, size_t> &pair : pairs)
+    pair = {distr(eng) % 16 + 1, distr(eng)};
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+        algorithms.GetShortestPathsBetweenPairs(graph, pairs));
+  SetLabel(state);
+}
+
+void BM_ShortestPathsBetweenAllVertices(benchmark::State &state) {
+  s21::Graph graph = LoadGraph(state.range(0), state.range(1));
+  s21::GraphAlgorithms algorithms;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+        algorithms.GetShortestPathsBetweenAllVertices(graph));
+  SetLabel(state);
+}
+
+void BM_LeastSpanningTree(benchmark::State &state) {
+  s21::Graph graph = LoadGraph(state.range(0), state.range(1));
+  s21::GraphAlgorithms algorithms;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(algorithms.GetLeastSpanningTree(graph));
+  SetLabel(state);
+}
+
+void BM_TravelingSalesmanProblem(benchmark::State &state) {
+  s21::Graph graph = LoadGraph(state.range(0), state.range(1));
+  s21::GraphAlgorithms algorithms;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(algorithms.SolveTravelingSalesmanProblem(graph));
+  SetLabel(state);
+}
+
+void BM_DeltaStepping(benchmark::State &state) {
+  s21::Graph graph = LoadGraph(state.range(0), 4000);
+  s21::DeltaStepping search(graph, state.range(1));
+  s21::ThreadPool pool(state.range(2));
+  for (auto _ : state) benchmark::DoNotOptimize(search.Search(1, pool));
+  SetLabel(state);
+}
+
+// Argument 0 keeps the file order, 1..3 apply s21::VertexOrder values.
+s21::Graph LoadGrid(size_t side, bool weighted, int64_t order) {
+  s21::Graph graph = LoadGraph(kGrid, side * side, weighted);
+  if (order > 0) graph.Reorder(static_cast<s21::VertexOrder>(order - 1));
+  return graph;
+}
+
+void BM_ReorderedBreadthFirstSearch(benchmark::State &state) {
+  s21::Graph graph = LoadGrid(state.range(0), false, state.range(1));
+  s21::GraphAlgorithms algorithms;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(algorithms.BreadthFirstSearch(graph, 1));
+}
+
+void BM_ReorderedShortestPath(benchmark::State &state) {
+  s21::Graph graph = LoadGrid(state.range(0), true, state.range(1));
+  s21::GraphAlgorithms algorithms;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(algorithms.GetShortestPathBetweenVertices(
+        graph, 1, graph.GetVertices()));
+}
+
+void BM_Reorder(benchmark::State &state) {
+  s21::Graph graph = LoadGrid(state.range(0), false, 0);
+  for (auto _ : state)
+    graph.Reorder(static_cast<s21::VertexOrder>(state.range(1) - 1));
+}
+}  // namespace
+
+// Arguments are {kind, vertices}.
+BENCHMARK(BM_LoadGraphFromFile)
+    ->ArgsProduct({kKinds, kSizes})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DepthFirstSearch)
+    ->ArgsProduct({kKinds, kSizes})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BreadthFirstSearch)
+    ->ArgsProduct({kKinds, kSizes})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_HopDistancesFromVertices)
+    ->ArgsProduct({kKinds, kSizes})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ShortestPathBetweenVertices)
+    ->ArgsProduct({kKinds, kSizes})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ShortestPathsFromVertex)
+    ->ArgsProduct({kKinds, kSizes})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ShortestPathsBetweenPairs)
+    ->ArgsProduct({kKinds, kSizes})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ShortestPathsBetweenAllVertices)
+    ->ArgsProduct({kKinds, kCubicSizes})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LeastSpanningTree)
+    ->ArgsProduct({kKinds, kCubicSizes})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TravelingSalesmanProblem)
+    ->ArgsProduct({kKinds, kCubicSizes})
+    ->Unit(benchmark::kMillisecond);
+// Arguments are {kind, delta, threads}; weights are 1..9, so delta 9 makes
+// every edge light. Compare with BM_ShortestPathsFromVertex at 4000.
+BENCHMARK(BM_DeltaStepping)
+    ->ArgsProduct({{kRandom, kGrid}, {1, 3, 9, 27}, {1, 2, 4}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// Arguments are {grid side, vertex order}.
+BENCHMARK(BM_ReorderedBreadthFirstSearch)
+    ->ArgsProduct({{32, 64}, {0, 1, 2, 3}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ReorderedShortestPath)
+    ->ArgsProduct({{32, 64}, {0, 1, 2, 3}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Reorder)
+    ->ArgsProduct({{64}, {1, 2, 3}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -1,6 +1,47 @@
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
 #include "s21_navigator_interface.hpp"
+#include "s21_navigator_server.hpp"
 
-int main() {
+// Without arguments the interactive menu starts. Otherwise:
+//   navigator [--json] --script FILE   runs the commands from FILE
+//   navigator [--json] COMMAND...      runs the commands given as arguments
+//   navigator --serve SOCKET           answers queries on a Unix socket
+int main(int argc, char *argv[]) {
   s21::NavigatorInterface n;
-  n.Start();
-}
\ No newline at end of file
+  if (argc == 1) {
+    n.Start();
+    return 0;
+  }
+  if (argc == 3 && std::strcmp(argv[1], "--serve") == 0) {
+    try {
+      s21::NavigatorServer server(argv[2]);
+      server.Run();
+    } catch (const std::exception &error) {
+      std::cerr << error.what() << std::endl;
+      return 1;
+    }
+    return 0;
+  }
+  auto format = s21::NavigatorInterface::OutputFormat::kCsv;
+  int first = 1;
+  if (std::strcmp(argv[first], "--json") == 0) {
+    format = s21::NavigatorInterface::OutputFormat::kJson;
+    first++;
+  }
+  if (first + 1 < argc && std::strcmp(argv[first], "--script") == 0) {
+    std::ifstream script(argv[first + 1]);
+    if (!script.good()) {
+      std::cerr << "Wrong filename" << std::endl;
+      return 1;
+    }
+    n.RunBatch(script, std::cout, format);
+    return 0;
+  }
+  std::stringstream script;
+  for (int i = first; i < argc; i++) script << argv[i] << ' ';
+  n.RunBatch(script, std::cout, format);
+  return 0;
+}
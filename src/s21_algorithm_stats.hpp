@@ -0,0 +1,138 @@
+#ifndef SRC_S21_ALGORITHM_STATS_H_
+#define SRC_S21_ALGORITHM_STATS_H_
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+namespace s21 {
+// What one call did. Counters that do not apply to the algorithm stay zero.
+struct AlgorithmStats {
+  const char *algorithm = "";
+  double microseconds = 0;
+  // Dijkstra and Prim.
+  size_t vertices_settled = 0;
+  size_t edges_relaxed = 0;
+  // Floyd-Warshall.
+  size_t relaxations = 0;
+  // Ant colony. The entropy of the final pheromone trails is normalised to
+  // [0, 1]: 1 when every edge is equally marked, near 0 once the colony has
+  // settled on one tour.
+  size_t ant_steps = 0;
+  size_t dead_ends = 0;
+  size_t iterations_to_best = 0;
+  double pheromone_entropy = 0;
+  // LoadGraphFromFile: reading the numbers and the whole call.
+  double parse_microseconds = 0;
+  double load_microseconds = 0;
+};
+
+using StatsCallback = std::function<void(const AlgorithmStats &)>;
+
+#ifdef S21_STATS
+constexpr bool kStatsEnabled = true;
+#else
+constexpr bool kStatsEnabled = false;
+#endif
+
+// Where an instrumented class keeps its callback. The disabled
+// specialisation is empty, so builds without S21_STATS carry no
+// std::function per object.
+template <bool Enabled>
+struct BasicStatsSlot {
+  void Set(StatsCallback value) { callback = std::move(value); }
+
+  StatsCallback callback;
+};
+
+template <>
+struct BasicStatsSlot<false> {
+  void Set(const StatsCallback &) {}
+};
+
+using StatsSlot = BasicStatsSlot<kStatsEnabled>;
+
+// Collects the counters of one call and hands them to the callback when it
+// goes out of scope. Building without S21_STATS selects the empty
+// specialisation, so the instrumented code compiles to nothing.
+template <bool Enabled>
+class BasicStatsScope {
+ public:
+  static constexpr bool kEnabled = true;
+
+  BasicStatsScope() : callback_(nullptr) {}
+
+  BasicStatsScope(const StatsCallback &callback, const char *algorithm)
+      : callback_(callback ? &callback : nullptr),
+        start_(std::chrono::steady_clock::now()) {
+    stats_.algorithm = algorithm;
+  }
+
+  BasicStatsScope(const BasicStatsSlot<true> &slot, const char *algorithm)
+      : BasicStatsScope(slot.callback, algorithm) {}
+
+  BasicStatsScope(const BasicStatsScope &) = delete;
+  BasicStatsScope &operator=(const BasicStatsScope &) = delete;
+
+  ~BasicStatsScope() {
+    if (!callback_) return;
+    stats_.microseconds = GetMicroseconds(start_);
+    (*callback_)(stats_);
+  }
+
+  void Add(size_t AlgorithmStats::*counter, size_t count = 1) {
+    stats_.*counter += count;
+  }
+
+  void Set(size_t AlgorithmStats::*counter, size_t value) {
+    stats_.*counter = value;
+  }
+
+  void Set(double AlgorithmStats::*value, double amount) {
+    stats_.*value = amount;
+  }
+
+  // Adds the counters of a scope filled by another worker.
+  void Merge(const BasicStatsScope &other) {
+    stats_.vertices_settled += other.stats_.vertices_settled;
+    stats_.edges_relaxed += other.stats_.edges_relaxed;
+    stats_.relaxations += other.stats_.relaxations;
+    stats_.ant_steps += other.stats_.ant_steps;
+    stats_.dead_ends += other.stats_.dead_ends;
+  }
+
+  std::chrono::steady_clock::time_point Now() const {
+    return std::chrono::steady_clock::now();
+  }
+
+  static double GetMicroseconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+  }
+
+ private:
+  const StatsCallback *callback_;
+  std::chrono::steady_clock::time_point start_;
+  AlgorithmStats stats_;
+};
+
+template <>
+class BasicStatsScope<false> {
+ public:
+  static constexpr bool kEnabled = false;
+
+  BasicStatsScope() {}
+  BasicStatsScope(const StatsCallback &, const char *) {}
+  BasicStatsScope(const BasicStatsSlot<false> &, const char *) {}
+  void Add(size_t AlgorithmStats::*, size_t = 1) {}
+  void Set(size_t AlgorithmStats::*, size_t) {}
+  void Set(double AlgorithmStats::*, double) {}
+  void Merge(const BasicStatsScope &) {}
+  int Now() const { return 0; }
+  static double GetMicroseconds(int) { return 0; }
+};
+
+using StatsScope = BasicStatsScope<kStatsEnabled>;
+}  // namespace s21
+#endif  // SRC_S21_ALGORITHM_STATS_H_
@@ -1,3 +1,6 @@
+#ifndef SRC_S21_ANT_H_
+#define SRC_S21_ANT_H_
+#include <cmath>
 #include <random>
 #include <vector>
 
@@ -17,20 +20,22 @@ class Ant {
 
   void ResetAnts() {
     distance_ = 0;
-    visited_ = std::vector<bool>(kSize, false);
+    visited_.assign((kSize + Graph::kWordBits - 1) / Graph::kWordBits, 0);
     vertices_.clear();
     position_ = GetRandomposition();
     next_position_ = -1;
-    visited_[position_] = true;
+    SetVisited(position_);
     vertices_.push_back(position_);
   }
 
-  void Move(Graph g, std::vector<std::vector<double>> &p) {
+  template <typename T>
+  void Move(const BasicGraph<T> &g,
+            const std::vector<std::vector<double>> &p) {
     next_position_ = -1;
     int count = 0;
     while (next_position_ == -1) {
       next_position_ = ChoosePath(g, p);
-      if (count == 100) {
+      if (count == 100 || candidates_.empty()) {
         SetDeadEnd();
         break;
       }
@@ -40,12 +45,13 @@ class Ant {
     if (position_ != -1 && next_position_ != -1) {
       distance_ += g.GetIndex(position_, next_position_);
       position_ = next_position_;
-      visited_[position_] = true;
+      SetVisited(position_);
       vertices_.push_back(position_);
     }
   }
 
-  void Return(Graph g) {
+  template <typename T>
+  void Return(const BasicGraph<T> &g) {
     if (g.GetIndex(position_, vertices_[0]) > 0) {
       distance_ += g.GetIndex(position_, vertices_[0]);
       vertices_.push_back(vertices_[0]);
@@ -62,7 +68,9 @@ class Ant {
   int position_, next_position_;
   double distance_;
   std::vector<int> vertices_;
-  std::vector<bool> visited_;
+  std::vector<uint64_t> visited_;
+  std::vector<int> candidates_;
+  std::vector<double> attractiveness_;
 
   double GetRandomNumber() {
     std::random_device rd;
@@ -71,35 +79,53 @@ class Ant {
     return distr(eng);
   }
 
-  double GetAttractiveness(int target, Graph g,
-                           std::vector<std::vector<double>> p) {
-    double avalible_paths = 0;
-    for (size_t i = 0; i < kSize; i++)
-      if (g.GetIndex(position_, i) > 0 && !visited_[i])
-        avalible_paths += GetPathAttractivness(i, g, p);
-    avalible_paths = GetPathAttractivness(target, g, p) / avalible_paths;
-    return avalible_paths;
+  void SetVisited(size_t i) {
+    visited_[i / Graph::kWordBits] |= uint64_t(1) << (i % Graph::kWordBits);
   }
 
-  double GetPathAttractivness(int target, Graph g,
-                              std::vector<std::vector<double>> p) {
+  bool IsVisited(size_t i) {
+    return (visited_[i / Graph::kWordBits] >> (i % Graph::kWordBits)) & 1;
+  }
+
+  // Unvisited neighbours of the current position; on a bit matrix they are
+  // row & ~visited, taken a word at a time.
+  template <typename T>
+  void CollectCandidates(const BasicGraph<T> &g) {
+    candidates_.clear();
+    if (g.IsPacked()) {
+      const uint64_t *row = g.GetAdjacencyRow(position_);
+      for (size_t w = 0; w < visited_.size(); w++)
+        for (uint64_t bits = row[w] & ~visited_[w]; bits; bits &= bits - 1)
+          candidates_.push_back(w * Graph::kWordBits + __builtin_ctzll(bits));
+    } else {
+      for (size_t i = 0; i < kSize; i++)
+        if (g.GetIndex(position_, i) > 0 && !IsVisited(i))
+          candidates_.push_back(i);
+    }
+  }
+
+  template <typename T>
+  double GetPathAttractivness(int target, const BasicGraph<T> &g,
+                              const std::vector<std::vector<double>> &p) {
     return std::pow(p[position_][target], kAlpha) *
            std::pow(1.0 / g.GetIndex(position_, target), kBeta);
   }
 
-  int ChoosePath(Graph g, std::vector<std::vector<double>> p) {
-    double sum = 0, random = GetRandomNumber();
-    size_t i = -1;
-    while (sum < random) {
-      i++;
-      if (i == kSize) {
-        i = -1;
-        break;
-      }
-      if (g.GetIndex(position_, i) > 0 && !visited_[i])
-        sum += GetAttractiveness(i, g, p);
+  template <typename T>
+  int ChoosePath(const BasicGraph<T> &g,
+                 const std::vector<std::vector<double>> &p) {
+    double sum = 0, avalible_paths = 0, random = GetRandomNumber();
+    CollectCandidates(g);
+    attractiveness_.clear();
+    for (int candidate : candidates_) {
+      attractiveness_.push_back(GetPathAttractivness(candidate, g, p));
+      avalible_paths += attractiveness_.back();
+    }
+    for (size_t i = 0; i < candidates_.size(); i++) {
+      sum += attractiveness_[i] / avalible_paths;
+      if (sum >= random) return candidates_[i];
     }
-    return i;
+    return -1;
   }
 
   int GetRandomposition() {
@@ -115,3 +141,4 @@ class Ant {
   }
 };
 }  // namespace s21
+#endif  // SRC_S21_ANT_H_
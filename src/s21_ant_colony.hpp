@@ -1,4 +1,10 @@
+#ifndef SRC_S21_ANT_COLONY_H_
+#define SRC_S21_ANT_COLONY_H_
+#include <cmath>
+
+#include "s21_algorithm_stats.hpp"
 #include "s21_ant.hpp"
+#include "s21_task_control.hpp"
 
 namespace s21 {
 
@@ -21,24 +27,36 @@ class AntColony {
         kSize, std::vector<double>(kSize, 0.001));
   }
 
-  TsmResult AntAnlgorithm(Graph g, size_t iterations) {
+  // Checks for cancellation before every iteration; a cancelled run returns
+  // the best tour found so far, which is empty if there was none.
+  template <typename T>
+  TsmResult AntAnlgorithm(const BasicGraph<T> &g, size_t iterations,
+                          StatsScope &stats, const TaskControl &control) {
     std::vector<Ant> ants(kNumberOfAnts, Ant(kSize, kAlpha, kBeta));
-    for (size_t i = 0; i < iterations; i++) {
+    for (size_t i = 0; i < iterations && !control.IsCancelled(); i++) {
       for (size_t k = 0; k < kNumberOfAnts; k++) {
         ants[k].ResetAnts();
         for (size_t j = 1; j < kSize; j++)
-          if (!ants[k].GetDeadEnd()) ants[k].Move(g, pheromon_);
+          if (!ants[k].GetDeadEnd()) {
+            ants[k].Move(g, pheromon_);
+            if (!ants[k].GetDeadEnd()) stats.Add(&AlgorithmStats::ant_steps);
+          }
         if (!ants[k].GetDeadEnd()) ants[k].Return(g);
+        if (ants[k].GetDeadEnd()) stats.Add(&AlgorithmStats::dead_ends);
         if (ants[k].GetDistance() < result_.distance &&
             ants[k].GetDistance() != 0) {
           result_.distance = ants[k].GetDistance();
           result_.vertices = ants[k].GetVertices();
+          stats.Set(&AlgorithmStats::iterations_to_best, i + 1);
         }
         PheromoneUpdate(ants[k].GetVertices(), ants[k].GetDistance());
       }
       EvaporatePheromone(g);
       PheromoneUpdate(result_.vertices, result_.distance);
+      control.Report(i + 1, iterations);
     }
+    if constexpr (StatsScope::kEnabled)
+      stats.Set(&AlgorithmStats::pheromone_entropy, GetPheromoneEntropy(g));
     if (!result_.vertices.empty())
       if (result_.vertices[0] != 0) FlipAnswer(result_);
     for (size_t i = 0; i < result_.vertices.size(); i++) result_.vertices[i]++;
@@ -51,12 +69,35 @@ class AntColony {
   std::vector<std::vector<double>> pheromon_;
   TsmResult result_;
 
-  void EvaporatePheromone(Graph g) {
+  template <typename T>
+  void EvaporatePheromone(const BasicGraph<T> &g) {
     for (size_t i = 0; i < g.GetVertices(); i++)
       for (size_t j = 0; j < g.GetVertices(); j++)
         if (g.GetIndex(i, j) > 0) pheromon_[i][j] *= (1.0 - kEvaporation);
   }
 
+  // Shannon entropy of the trail strengths over the edges, divided by its
+  // maximum.
+  template <typename T>
+  double GetPheromoneEntropy(const BasicGraph<T> &g) {
+    double total = 0, entropy = 0;
+    size_t edges = 0;
+    for (size_t i = 0; i < kSize; i++)
+      for (size_t j = 0; j < kSize; j++)
+        if (g.GetIndex(i, j) > 0) {
+          total += pheromon_[i][j];
+          edges++;
+        }
+    if (edges < 2 || total <= 0) return 0;
+    for (size_t i = 0; i < kSize; i++)
+      for (size_t j = 0; j < kSize; j++)
+        if (g.GetIndex(i, j) > 0 && pheromon_[i][j] > 0) {
+          double share = pheromon_[i][j] / total;
+          entropy -= share * std::log(share);
+        }
+    return entropy / std::log(static_cast<double>(edges));
+  }
+
   void FlipAnswer(TsmResult &result) {
     std::vector<int> temp;
     size_t initial_position =
@@ -79,3 +120,4 @@ class AntColony {
   }
 };
 }  // namespace s21
+#endif  // SRC_S21_ANT_COLONY_H_
@@ -0,0 +1,74 @@
+#ifndef SRC_S21_BUFFERED_WRITER_H_
+#define SRC_S21_BUFFERED_WRITER_H_
+#include <charconv>
+#include <cmath>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+namespace s21 {
+// Collects output in a large string and hands it to the stream in big
+// chunks, instead of flushing every line as std::endl does.
+class BufferedWriter {
+ public:
+  explicit BufferedWriter(std::ostream &out, size_t capacity = 1 << 20)
+      : out_(out), capacity_(capacity) {
+    buffer_.reserve(capacity_);
+  }
+
+  BufferedWriter(const BufferedWriter &) = delete;
+  BufferedWriter &operator=(const BufferedWriter &) = delete;
+
+  ~BufferedWriter() { Flush(); }
+
+  BufferedWriter &operator<<(const std::string &text) {
+    buffer_ += text;
+    return Spill();
+  }
+
+  BufferedWriter &operator<<(const char *text) {
+    buffer_ += text;
+    return Spill();
+  }
+
+  BufferedWriter &operator<<(char symbol) {
+    buffer_ += symbol;
+    return Spill();
+  }
+
+  // Numbers are formatted with std::to_chars: the shortest exact form and no
+  // locale. Infinite values are written as "inf".
+  template <typename V,
+            typename = std::enable_if_t<std::is_arithmetic_v<V> &&
+                                        !std::is_same_v<V, char> &&
+                                        !std::is_same_v<V, bool>>>
+  BufferedWriter &operator<<(V value) {
+    if constexpr (std::is_floating_point_v<V>)
+      if (std::isinf(value)) return *this << (value < 0 ? "-inf" : "inf");
+    char digits[64];
+    std::to_chars_result end = std::to_chars(digits, digits + 64, value);
+    buffer_.append(digits, end.ptr);
+    return Spill();
+  }
+
+  void Flush() {
+    out_.write(buffer_.data(), buffer_.size());
+    out_.flush();
+    buffer_.clear();
+  }
+
+ private:
+  std::ostream &out_;
+  const size_t capacity_;
+  std::string buffer_;
+
+  BufferedWriter &Spill() {
+    if (buffer_.size() >= capacity_) {
+      out_.write(buffer_.data(), buffer_.size());
+      buffer_.clear();
+    }
+    return *this;
+  }
+};
+}  // namespace s21
+#endif  // SRC_S21_BUFFERED_WRITER_H_
@@ -0,0 +1,204 @@
+#ifndef SRC_S21_DELTA_STEPPING_H_
+#define SRC_S21_DELTA_STEPPING_H_
+#include <algorithm>
+#include <exception>
+#include <map>
+#include <vector>
+
+#include "s21_graph.hpp"
+#include "s21_thread_pool.hpp"
+
+namespace s21 {
+// Parallel single-source shortest paths by delta-stepping (Meyer and
+// Sanders). Tentative distances are kept in buckets delta wide. The lowest
+// non-empty bucket is emptied in phases that relax the light edges
+// (weight <= delta) of its vertices, which may refill it; the heavy edges of
+// everything it held are relaxed once at the end. In each phase the pool
+// workers scan a share of the frontier and queue relaxation requests in
+// buffers of their own, one per owner; then every owner applies the requests
+// for its vertices, so no distance is written by two threads.
+//
+// The constructor splits the adjacency matrix into light and heavy edge
+// lists once. The graph must outlive the object and must not change while
+// it is used. Search calls ParallelFor and must not run inside a pool task.
+template <typename T>
+class BasicDeltaStepping {
+ public:
+  using distance_type = typename WeightTraits<T>::distance_type;
+
+  // Distances are indexed from 0 in the original vertex order and are
+  // WeightTraits<T>::Infinity() for unreachable vertices. parents holds the
+  // 1-based vertex before each one on a shortest path, 0 for the source and
+  // for unreachable vertices.
+  struct ShortestPathTree {
+    std::vector<distance_type> distances;
+    std::vector<size_t> parents;
+  };
+
+  BasicDeltaStepping(const BasicGraph<T> &graph, distance_type delta)
+      : graph_(graph), delta_(delta) {
+    if (graph_.GetVertices() < 2 || !(delta_ > 0)) throw std::exception();
+    size_t size = graph_.GetVertices();
+    light_.offsets.assign(1, 0);
+    heavy_.offsets.assign(1, 0);
+    for (size_t i = 0; i < size; i++) {
+      for (size_t j = 0; j < size; j++) {
+        T weight = graph_.GetIndex(i, j);
+        if (weight > 0) (weight <= delta_ ? light_ : heavy_).Add(j, weight);
+      }
+      light_.offsets.push_back(light_.targets.size());
+      heavy_.offsets.push_back(heavy_.targets.size());
+    }
+  }
+
+  distance_type GetDelta() const { return delta_; }
+
+  ShortestPathTree Search(size_t start_vertex,
+                          ThreadPool &pool = ThreadPool::Shared()) {
+    size_t size = graph_.GetVertices();
+    if (start_vertex < 1 || start_vertex > size) throw std::exception();
+    Prepare(pool.GetThreads());
+    size_t source = graph_.GetInternalVertex(start_vertex - 1);
+    Relax({source, kNone, 0}, source % owners_.size());
+    std::vector<size_t> frontier, settled;
+    for (size_t bucket = 0; FindBucket(bucket); bucket++) {
+      settled.clear();
+      while (TakeBucket(bucket, frontier)) {
+        settled.insert(settled.end(), frontier.begin(), frontier.end());
+        Phase(pool, frontier, light_);
+      }
+      Phase(pool, settled, heavy_);
+    }
+    ShortestPathTree res{std::vector<distance_type>(size),
+                         std::vector<size_t>(size, 0)};
+    for (size_t i = 0; i < size; i++) {
+      res.distances[graph_.GetOriginalVertex(i)] = distances_[i];
+      if (parents_[i] != kNone)
+        res.parents[graph_.GetOriginalVertex(i)] =
+            graph_.GetOriginalVertex(parents_[i]) + 1;
+    }
+    return res;
+  }
+
+ private:
+  static constexpr size_t kNone = static_cast<size_t>(-1);
+
+  struct EdgeList {
+    std::vector<size_t> offsets;
+    std::vector<size_t> targets;
+    std::vector<T> weights;
+
+    void Add(size_t target, T weight) {
+      targets.push_back(target);
+      weights.push_back(weight);
+    }
+  };
+
+  struct Request {
+    size_t vertex;
+    size_t parent;
+    distance_type distance;
+  };
+
+  // Vertices are owned by position modulo the number of owners; each owner
+  // keeps its share of the buckets that are not empty, by index, so a heavy
+  // edge far beyond delta costs one entry rather than a bucket per step.
+  struct Owner {
+    std::map<size_t, std::vector<size_t>> buckets;
+  };
+
+  const BasicGraph<T> &graph_;
+  const distance_type delta_;
+  EdgeList light_, heavy_;
+  std::vector<distance_type> distances_;
+  std::vector<size_t> parents_;
+  std::vector<distance_type> taken_;
+  std::vector<Owner> owners_;
+  // requests_[worker][owner], filled by one worker and drained by one owner.
+  std::vector<std::vector<std::vector<Request>>> requests_;
+
+  void Prepare(size_t threads) {
+    size_t size = graph_.GetVertices();
+    distances_.assign(size, WeightTraits<T>::Infinity());
+    parents_.assign(size, kNone);
+    taken_.assign(size, WeightTraits<T>::Infinity());
+    owners_.assign(threads, Owner());
+    requests_.assign(threads, std::vector<std::vector<Request>>(threads));
+  }
+
+  size_t GetBucket(distance_type distance) const {
+    return static_cast<size_t>(distance / delta_);
+  }
+
+  void Relax(const Request &request, size_t owner) {
+    if (!(request.distance < distances_[request.vertex])) return;
+    distances_[request.vertex] = request.distance;
+    parents_[request.vertex] = request.parent;
+    owners_[owner].buckets[GetBucket(request.distance)].push_back(
+        request.vertex);
+  }
+
+  // Moves bucket to the lowest index that is not empty in some owner.
+  // Relaxing never reaches below the bucket being emptied, so every key left
+  // is at least bucket.
+  bool FindBucket(size_t &bucket) const {
+    bool found = false;
+    for (const Owner &owner : owners_)
+      if (!owner.buckets.empty() &&
+          (!found || owner.buckets.begin()->first < bucket)) {
+        bucket = owner.buckets.begin()->first;
+        found = true;
+      }
+    return found;
+  }
+
+  // Empties the bucket into frontier. Entries left behind by a later
+  // shortening and vertices already taken at their current distance are
+  // skipped.
+  bool TakeBucket(size_t bucket, std::vector<size_t> &frontier) {
+    frontier.clear();
+    for (Owner &owner : owners_) {
+      auto entry = owner.buckets.find(bucket);
+      if (entry == owner.buckets.end()) continue;
+      for (size_t vertex : entry->second)
+        if (GetBucket(distances_[vertex]) == bucket &&
+            taken_[vertex] != distances_[vertex]) {
+          taken_[vertex] = distances_[vertex];
+          frontier.push_back(vertex);
+        }
+      owner.buckets.erase(entry);
+    }
+    return !frontier.empty();
+  }
+
+  // Relaxes the given edges of every vertex in frontier: requests are
+  // generated in parallel chunks, then applied in parallel by owner.
+  void Phase(ThreadPool &pool, const std::vector<size_t> &frontier,
+             const EdgeList &edges) {
+    size_t workers = owners_.size();
+    size_t chunks = std::min(workers, frontier.size());
+    pool.ParallelFor(chunks, [&](size_t worker, size_t chunk) {
+      std::vector<std::vector<Request>> &buffers = requests_[worker];
+      for (size_t i = chunk * frontier.size() / chunks;
+           i < (chunk + 1) * frontier.size() / chunks; i++) {
+        size_t vertex = frontier[i];
+        distance_type base = distances_[vertex];
+        for (size_t e = edges.offsets[vertex]; e < edges.offsets[vertex + 1];
+             e++)
+          buffers[edges.targets[e] % workers].push_back(
+              {edges.targets[e], vertex,
+               WeightTraits<T>::Add(base, edges.weights[e])});
+      }
+    });
+    pool.ParallelFor(workers, [&](size_t, size_t owner) {
+      for (std::vector<std::vector<Request>> &buffers : requests_) {
+        for (const Request &request : buffers[owner]) Relax(request, owner);
+        buffers[owner].clear();
+      }
+    });
+  }
+};
+
+using DeltaStepping = BasicDeltaStepping<int>;
+}  // namespace s21
+#endif  // SRC_S21_DELTA_STEPPING_H_
@@ -0,0 +1,105 @@
+#ifndef SRC_S21_DYNAMIC_SHORTEST_PATHS_H_
+#define SRC_S21_DYNAMIC_SHORTEST_PATHS_H_
+#include <utility>
+#include <vector>
+
+#include "s21_graph_algorithms.hpp"
+
+namespace s21 {
+// All-pairs shortest distances that follow edge updates made through this
+// object. Distances are indexed from 0 in the original vertex order; the
+// distance of an unreachable pair is WeightTraits<T>::Infinity(). The graph
+// must outlive the object and must not be changed behind its back.
+template <typename T>
+class BasicDynamicShortestPaths {
+ public:
+  using distance_type = typename WeightTraits<T>::distance_type;
+
+  explicit BasicDynamicShortestPaths(BasicGraph<T> &graph) : graph_(graph) {
+    if (graph_.GetVertices() < 2) throw std::exception();
+    distances_.resize(graph_.GetVertices());
+    ThreadPool::Shared().ParallelFor(
+        distances_.size(), [this](size_t, size_t vertex) {
+          distances_[vertex] =
+              BasicGraphAlgorithms<T>().GetShortestPathsFromVertex(graph_,
+                                                                   vertex + 1);
+        });
+  }
+
+  distance_type GetDistance(size_t vertex1, size_t vertex2) const {
+    if (vertex1 < 1 || vertex1 > distances_.size() || vertex2 < 1 ||
+        vertex2 > distances_.size())
+      throw std::exception();
+    return distances_[vertex1 - 1][vertex2 - 1];
+  }
+
+  const std::vector<std::vector<distance_type>> &GetDistances() const {
+    return distances_;
+  }
+
+  // Inserting or shortening an edge costs O(V^2); lengthening or removing it
+  // reruns Dijkstra only from the sources whose shortest paths used it.
+  void SetEdge(size_t vertex1, size_t vertex2, T weight) {
+    std::vector<Change> changes = {{vertex1, vertex2, 0, weight}};
+    if (!graph_.GetOriented() && vertex1 != vertex2)
+      changes.push_back({vertex2, vertex1, 0, weight});
+    for (Change &change : changes)
+      change.old_weight = graph_.GetEdge(change.from, change.to);
+    graph_.SetEdge(vertex1, vertex2, weight);
+    for (const Change &change : changes) {
+      if (change.old_weight == change.new_weight) continue;
+      if (change.new_weight != 0 &&
+          (change.old_weight == 0 || change.new_weight < change.old_weight))
+        Decrease(change);
+      else
+        Increase(change);
+    }
+  }
+
+  void RemoveEdge(size_t vertex1, size_t vertex2) {
+    SetEdge(vertex1, vertex2, 0);
+  }
+
+ private:
+  struct Change {
+    size_t from, to;
+    T old_weight, new_weight;
+  };
+
+  BasicGraph<T> &graph_;
+  std::vector<std::vector<distance_type>> distances_;
+
+  static distance_type Add(distance_type a, distance_type b) {
+    return WeightTraits<T>::Add(a, b);
+  }
+
+  void Decrease(const Change &change) {
+    size_t from = change.from - 1, to = change.to - 1;
+    const std::vector<distance_type> &tail = distances_[to];
+    for (std::vector<distance_type> &row : distances_) {
+      distance_type via = Add(row[from], change.new_weight);
+      if (via >= row[to]) continue;
+      for (size_t j = 0; j < row.size(); j++)
+        row[j] = std::min(row[j], Add(via, tail[j]));
+    }
+  }
+
+  void Increase(const Change &change) {
+    size_t from = change.from - 1, to = change.to - 1;
+    std::vector<size_t> affected;
+    for (size_t i = 0; i < distances_.size(); i++)
+      if (distances_[i][from] != WeightTraits<T>::Infinity() &&
+          Add(distances_[i][from], change.old_weight) == distances_[i][to])
+        affected.push_back(i);
+    ThreadPool::Shared().ParallelFor(
+        affected.size(), [&](size_t, size_t item) {
+          distances_[affected[item]] =
+              BasicGraphAlgorithms<T>().GetShortestPathsFromVertex(
+                  graph_, affected[item] + 1);
+        });
+  }
+};
+
+using DynamicShortestPaths = BasicDynamicShortestPaths<int>;
+}  // namespace s21
+#endif  // SRC_S21_DYNAMIC_SHORTEST_PATHS_H_
@@ -0,0 +1,278 @@
+#ifndef SRC_S21_DYNAMIC_SPANNING_TREE_H_
+#define SRC_S21_DYNAMIC_SPANNING_TREE_H_
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "s21_graph.hpp"
+
+namespace s21 {
+// Minimum spanning forest of an unoriented graph that follows edge updates
+// made through this object. Tree paths live in a link-cut tree whose nodes
+// are the vertices plus one node per tree edge, so the heaviest edge on the
+// cycle closed by a new edge is found in amortised O(log V). Lengthening or
+// removing a tree edge has to look for a replacement across the cut and
+// scans the adjacency matrix once. The graph must outlive the object.
+template <typename T>
+class BasicDynamicSpanningTree {
+ public:
+  using distance_type = typename WeightTraits<T>::distance_type;
+
+  explicit BasicDynamicSpanningTree(BasicGraph<T> &graph)
+      : graph_(graph), size_(graph.GetVertices()), weight_(0) {
+    if (size_ < 2 || graph_.GetOriented()) throw std::exception();
+    nodes_.resize(size_);
+    std::vector<std::pair<size_t, size_t>> edges;
+    for (size_t i = 1; i <= size_; i++)
+      for (size_t j = i + 1; j <= size_; j++)
+        if (graph_.GetEdge(i, j) > 0) edges.emplace_back(i - 1, j - 1);
+    std::stable_sort(edges.begin(), edges.end(), [&](auto a, auto b) {
+      return GetWeight(a.first, a.second) < GetWeight(b.first, b.second);
+    });
+    std::vector<size_t> component(size_);
+    std::iota(component.begin(), component.end(), 0);
+    auto find = [&](size_t v) {
+      while (component[v] != v) v = component[v] = component[component[v]];
+      return v;
+    };
+    for (const std::pair<size_t, size_t> &edge : edges) {
+      size_t a = find(edge.first), b = find(edge.second);
+      if (a == b) continue;
+      component[a] = b;
+      AddTreeEdge(edge.first, edge.second,
+                  GetWeight(edge.first, edge.second));
+    }
+  }
+
+  distance_type GetTotalWeight() const { return weight_; }
+
+  // Adjacency matrix of the current forest, as GetLeastSpanningTree returns.
+  std::vector<std::vector<T>> GetTree() const {
+    std::vector<std::vector<T>> res(size_, std::vector<T>(size_));
+    for (const auto &edge : tree_edges_) {
+      size_t i = edge.first / size_, j = edge.first % size_;
+      res[i][j] = res[j][i] = nodes_[edge.second].weight;
+    }
+    return res;
+  }
+
+  bool IsTreeEdge(size_t vertex1, size_t vertex2) const {
+    return tree_edges_.count(GetKey(vertex1 - 1, vertex2 - 1)) != 0;
+  }
+
+  void SetEdge(size_t vertex1, size_t vertex2, T weight) {
+    T old_weight = graph_.GetEdge(vertex1, vertex2);
+    graph_.SetEdge(vertex1, vertex2, weight);
+    size_t u = vertex1 - 1, v = vertex2 - 1;
+    if (u == v || old_weight == weight) return;
+    auto tree_edge = tree_edges_.find(GetKey(u, v));
+    if (tree_edge == tree_edges_.end()) {
+      if (weight > 0) Offer(u, v, weight);
+    } else if (weight > 0 && weight < old_weight) {
+      RemoveTreeEdge(u, v);
+      AddTreeEdge(u, v, weight);
+    } else {
+      RemoveTreeEdge(u, v);
+      Reconnect(u, v);
+    }
+  }
+
+  void RemoveEdge(size_t vertex1, size_t vertex2) {
+    SetEdge(vertex1, vertex2, 0);
+  }
+
+ private:
+  static constexpr size_t kNone = static_cast<size_t>(-1);
+
+  struct Node {
+    size_t child[2] = {kNone, kNone};
+    size_t parent = kNone;
+    bool flip = false;
+    bool edge = false;
+    T weight = 0;
+    size_t ends[2] = {kNone, kNone};
+    size_t heaviest = kNone;
+  };
+
+  BasicGraph<T> &graph_;
+  const size_t size_;
+  distance_type weight_;
+  std::vector<Node> nodes_;
+  std::vector<size_t> free_nodes_;
+  std::unordered_map<size_t, size_t> tree_edges_;
+  std::vector<size_t> path_;
+
+  size_t GetKey(size_t u, size_t v) const {
+    return std::min(u, v) * size_ + std::max(u, v);
+  }
+
+  T GetWeight(size_t u, size_t v) const {
+    return graph_.GetEdge(u + 1, v + 1);
+  }
+
+  // A new or shortened non-tree edge replaces the heaviest edge of the cycle
+  // it closes, if that edge is heavier.
+  void Offer(size_t u, size_t v, T weight) {
+    if (FindRoot(u) != FindRoot(v)) {
+      AddTreeEdge(u, v, weight);
+      return;
+    }
+    MakeRoot(u);
+    Access(v);
+    Splay(v);
+    size_t heaviest = nodes_[v].heaviest;
+    if (heaviest == kNone || nodes_[heaviest].weight <= weight) return;
+    RemoveTreeEdge(nodes_[heaviest].ends[0], nodes_[heaviest].ends[1]);
+    AddTreeEdge(u, v, weight);
+  }
+
+  // Links the two trees split by removing (u, v) with the lightest edge of
+  // the graph that crosses between them, if there is one.
+  void Reconnect(size_t u, size_t v) {
+    size_t root = FindRoot(u);
+    std::vector<bool> side(size_);
+    for (size_t i = 0; i < size_; i++) side[i] = FindRoot(i) == root;
+    if (side[v]) return;
+    size_t from = kNone, to = kNone;
+    for (size_t i = 0; i < size_; i++) {
+      if (!side[i]) continue;
+      for (size_t j = 0; j < size_; j++) {
+        T weight = side[j] ? 0 : GetWeight(i, j);
+        if (weight > 0 && (from == kNone || weight < GetWeight(from, to))) {
+          from = i;
+          to = j;
+        }
+      }
+    }
+    if (from != kNone) AddTreeEdge(from, to, GetWeight(from, to));
+  }
+
+  void AddTreeEdge(size_t u, size_t v, T weight) {
+    size_t node = nodes_.size();
+    if (free_nodes_.empty()) {
+      nodes_.emplace_back();
+    } else {
+      node = free_nodes_.back();
+      free_nodes_.pop_back();
+      nodes_[node] = Node();
+    }
+    nodes_[node].edge = true;
+    nodes_[node].weight = weight;
+    nodes_[node].ends[0] = u;
+    nodes_[node].ends[1] = v;
+    nodes_[node].heaviest = node;
+    Link(u, node);
+    Link(node, v);
+    tree_edges_[GetKey(u, v)] = node;
+    weight_ += weight;
+  }
+
+  void RemoveTreeEdge(size_t u, size_t v) {
+    auto found = tree_edges_.find(GetKey(u, v));
+    size_t node = found->second;
+    Cut(u, node);
+    Cut(node, v);
+    weight_ -= nodes_[node].weight;
+    tree_edges_.erase(found);
+    free_nodes_.push_back(node);
+  }
+
+  size_t Heavier(size_t a, size_t b) const {
+    if (a == kNone) return b;
+    if (b == kNone) return a;
+    return nodes_[a].weight >= nodes_[b].weight ? a : b;
+  }
+
+  bool IsRoot(size_t x) const {
+    size_t p = nodes_[x].parent;
+    return p == kNone || (nodes_[p].child[0] != x && nodes_[p].child[1] != x);
+  }
+
+  void Update(size_t x) {
+    Node &node = nodes_[x];
+    node.heaviest = node.edge ? x : kNone;
+    for (size_t child : node.child)
+      if (child != kNone)
+        node.heaviest = Heavier(node.heaviest, nodes_[child].heaviest);
+  }
+
+  void Push(size_t x) {
+    Node &node = nodes_[x];
+    if (!node.flip) return;
+    std::swap(node.child[0], node.child[1]);
+    for (size_t child : node.child)
+      if (child != kNone) nodes_[child].flip = !nodes_[child].flip;
+    node.flip = false;
+  }
+
+  void Rotate(size_t x) {
+    size_t p = nodes_[x].parent, g = nodes_[p].parent;
+    int side = nodes_[p].child[1] == x;
+    size_t moved = nodes_[x].child[!side];
+    if (!IsRoot(p)) nodes_[g].child[nodes_[g].child[1] == p] = x;
+    nodes_[x].parent = g;
+    nodes_[x].child[!side] = p;
+    nodes_[p].parent = x;
+    nodes_[p].child[side] = moved;
+    if (moved != kNone) nodes_[moved].parent = p;
+    Update(p);
+    Update(x);
+  }
+
+  void Splay(size_t x) {
+    path_.assign(1, x);
+    for (size_t y = x; !IsRoot(y); y = nodes_[y].parent)
+      path_.push_back(nodes_[y].parent);
+    for (auto it = path_.rbegin(); it != path_.rend(); ++it) Push(*it);
+    while (!IsRoot(x)) {
+      size_t p = nodes_[x].parent, g = nodes_[p].parent;
+      if (!IsRoot(p))
+        Rotate((nodes_[g].child[0] == p) == (nodes_[p].child[0] == x) ? p : x);
+      Rotate(x);
+    }
+  }
+
+  void Access(size_t x) {
+    for (size_t last = kNone, y = x; y != kNone;
+         last = y, y = nodes_[y].parent) {
+      Splay(y);
+      nodes_[y].child[1] = last;
+      Update(y);
+    }
+    Splay(x);
+  }
+
+  void MakeRoot(size_t x) {
+    Access(x);
+    nodes_[x].flip = !nodes_[x].flip;
+  }
+
+  size_t FindRoot(size_t x) {
+    Access(x);
+    Push(x);
+    while (nodes_[x].child[0] != kNone) {
+      x = nodes_[x].child[0];
+      Push(x);
+    }
+    Splay(x);
+    return x;
+  }
+
+  void Link(size_t x, size_t y) {
+    MakeRoot(x);
+    nodes_[x].parent = y;
+  }
+
+  void Cut(size_t x, size_t y) {
+    MakeRoot(x);
+    Access(y);
+    nodes_[y].child[0] = nodes_[x].parent = kNone;
+    Update(y);
+  }
+};
+
+using DynamicSpanningTree = BasicDynamicSpanningTree<int>;
+}  // namespace s21
+#endif  // SRC_S21_DYNAMIC_SPANNING_TREE_H_
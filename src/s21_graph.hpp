@@ -1,30 +1,238 @@
+#ifndef SRC_S21_GRAPH_H_
+#define SRC_S21_GRAPH_H_
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <mutex>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "s21_algorithm_stats.hpp"
+
 namespace s21 {
-class Graph {
+// Distances are accumulated in a type at least as wide as int (double for
+// floating weights); the largest value of that type stands for "no path".
+template <typename T>
+struct WeightTraits {
+  using weight_type = T;
+  using distance_type = std::conditional_t<
+      std::is_floating_point_v<T>, double,
+      std::conditional_t<(sizeof(T) < sizeof(int)),
+                         std::conditional_t<std::is_unsigned_v<T>, uint32_t,
+                                            int32_t>,
+                         T>>;
+
+  static constexpr distance_type Infinity() {
+    if constexpr (std::is_floating_point_v<distance_type>)
+      return std::numeric_limits<distance_type>::infinity();
+    else
+      return std::numeric_limits<distance_type>::max();
+  }
+
+  static distance_type Add(distance_type a, distance_type b) {
+    if (a == Infinity() || b == Infinity()) return Infinity();
+    if constexpr (std::is_integral_v<distance_type>)
+      if (b > 0 && a > Infinity() - b) return Infinity();
+    return a + b;
+  }
+};
+
+// Vertex orderings for BasicGraph::Reorder: breadth-first from a minimum
+// degree vertex, reverse Cuthill-McKee, and descending degree.
+enum class VertexOrder { kBreadthFirst, kReverseCuthillMcKee, kDegree };
+
+template <typename T>
+class BasicGraph {
  public:
-  Graph() : vertices_(0), weighted_(false), oriented_(false) {}
+  using weight_type = T;
+  using distance_type = typename WeightTraits<T>::distance_type;
+
+  static constexpr size_t kWordBits = 64;
+
+  BasicGraph()
+      : vertices_(0),
+        words_per_row_(0),
+        weighted_(false),
+        oriented_(false),
+        packed_(false),
+        reordered_(false),
+        version_(NextVersion()) {}
+
+  bool IsEmpty() const { return (vertices_ == 0 ? true : false); }
+
+  T GetIndex(size_t i, size_t j) const {
+    if (packed_)
+      return (bits_[i * words_per_row_ + j / kWordBits] >> (j % kWordBits)) &
+             1;
+    return indices_[i][j];
+  }
+
+  size_t GetVertices() const { return vertices_; }
+
+  bool GetWeighted() const { return weighted_; }
+
+  bool GetOriented() const { return oriented_; }
+
+  // Changes on every load or mutation; values are unique across all graphs,
+  // so (version, query) identifies a result.
+  uint64_t GetVersion() const { return version_; }
+
+  // Unweighted graphs with only 0/1 entries are kept as a bit matrix: row i
+  // occupies GetWordsPerRow() words, bit j of the row is set for edge i -> j.
+  bool IsPacked() const { return packed_; }
+
+  size_t GetWordsPerRow() const { return words_per_row_; }
+
+  const uint64_t *GetAdjacencyRow(size_t i) const {
+    return bits_.data() + i * words_per_row_;
+  }
 
-  bool IsEmpty() { return (vertices_ == 0 ? true : false); }
+  // First internal position j >= from with an edge i -> j, or GetVertices().
+  size_t GetNextNeighbor(size_t i, size_t from) const {
+    if (!packed_) {
+      while (from < vertices_ && indices_[i][from] <= 0) from++;
+      return from;
+    }
+    const uint64_t *row = GetAdjacencyRow(i);
+    for (size_t w = from / kWordBits; w < words_per_row_; w++) {
+      uint64_t word = row[w];
+      if (w == from / kWordBits) word &= ~uint64_t(0) << (from % kWordBits);
+      if (word) return w * kWordBits + __builtin_ctzll(word);
+    }
+    return vertices_;
+  }
+
+  // Strongly connected components of an oriented graph, connected components
+  // otherwise. The index is built on first use after each load or mutation;
+  // concurrent queries are safe, the first one builds it and the others wait.
+  // Component ids follow a reverse topological order: an edge between two
+  // strongly connected components always leads to a smaller id.
+  size_t GetComponentId(size_t vertex) {
+    CheckVertices(vertex, vertex);
+    return GetComponents()[internal_[vertex - 1]];
+  }
+
+  size_t GetComponentCount() {
+    GetComponents();
+    return component_count_;
+  }
+
+  // True when no path leads from vertex1 to vertex2. For an oriented graph
+  // false only means that the component index cannot rule a path out.
+  bool IsUnreachable(size_t vertex1, size_t vertex2) {
+    size_t from = GetComponentId(vertex1), to = GetComponentId(vertex2);
+    return oriented_ ? from < to : from != to;
+  }
+
+  // GetIndex and GetAdjacencyRow address vertices by internal position, which
+  // differs from the 0-based file order once the graph has been reordered.
+  bool IsReordered() const { return reordered_; }
+
+  size_t GetOriginalVertex(size_t position) const {
+    return original_[position];
+  }
 
-  int GetIndex(int i, int j) { return indices_[i][j]; }
+  size_t GetInternalVertex(size_t vertex) const { return internal_[vertex]; }
 
-  size_t GetVertices() { return vertices_; }
+  void Reorder(VertexOrder order) {
+    std::vector<std::vector<size_t>> neighbors = GetUndirectedNeighbors();
+    if (order == VertexOrder::kDegree)
+      Permute(GetDegreeOrder(neighbors));
+    else
+      Permute(GetBreadthFirstOrder(
+          neighbors, order == VertexOrder::kReverseCuthillMcKee));
+  }
 
-  bool GetWeighted() { return weighted_; }
+  // Edge operations take 1-based vertex numbers in the original order. A
+  // weight of zero means no edge. Orientation is fixed by the loaded file:
+  // edits to an unoriented graph update the reverse edge as well, and an
+  // oriented graph stays oriented even when its edges become symmetric.
+  T GetEdge(size_t vertex1, size_t vertex2) const {
+    CheckVertices(vertex1, vertex2);
+    return GetOriginalIndex(vertex1 - 1, vertex2 - 1);
+  }
 
-  bool GetOriented() { return oriented_; }
+  void SetEdge(size_t vertex1, size_t vertex2, T weight) {
+    CheckVertices(vertex1, vertex2);
+    if constexpr (std::is_signed_v<T>)
+      if (weight < 0) throw std::exception();
+    if (packed_ && weight != 0 && weight != 1) Unpack();
+    size_t i = internal_[vertex1 - 1], j = internal_[vertex2 - 1];
+    Write(i, j, weight);
+    if (!oriented_) Write(j, i, weight);
+    weighted_ = heavy_edges_ > 0;
+    version_ = NextVersion();
+  }
 
+  void RemoveEdge(size_t vertex1, size_t vertex2) {
+    SetEdge(vertex1, vertex2, 0);
+  }
+
+  // Reports the load and parse time when built with S21_STATS.
+  void SetStatsCallback(StatsCallback callback) {
+    stats_callback_.Set(std::move(callback));
+  }
+
+  // Throws std::exception, leaving the graph as it was, when a weight is
+  // negative or does not fit in T. Rows are packed as they are read while
+  // every value is 0 or 1, so a 0/1 matrix never exists in dense form; the
+  // first other value moves the rows packed so far to a dense matrix.
   void LoadGraphFromFile(std::string filename) {
+    StatsScope stats(stats_callback_, "LoadGraphFromFile");
+    auto start = stats.Now();
     std::ifstream file(filename.c_str());
-    file >> vertices_;
-    indices_ = std::vector(vertices_, std::vector<int>(vertices_));
-    for (size_t i = 0; i < vertices_; i++)
-      for (size_t j = 0; j < vertices_; j++) file >> indices_[i][j];
+    // A file that cannot be read keeps the size and clears every edge.
+    size_t vertices = vertices_;
+    file >> vertices;
+    size_t words_per_row = (vertices + kWordBits - 1) / kWordBits;
+    std::vector<uint64_t> bits(vertices * words_per_row, 0);
+    std::vector<std::vector<T>> indices;
+    bool packed = true;
+    std::vector<T> row(vertices);
+    // Read through a wide type so that 8-bit weights are not parsed as chars.
+    std::conditional_t<std::is_floating_point_v<T>, double, long long> value;
+    auto parse_start = stats.Now();
+    for (size_t i = 0; i < vertices; i++) {
+      for (size_t j = 0; j < vertices; j++) {
+        row[j] = 0;
+        if (!(file >> value)) continue;
+        if (!(value >= 0) || value > std::numeric_limits<T>::max())
+          throw std::exception();
+        row[j] = static_cast<T>(value);
+      }
+      if (packed && PackRow(row, bits.data() + i * words_per_row)) continue;
+      if (packed) {
+        indices.assign(vertices, std::vector<T>(vertices));
+        for (size_t k = 0; k < i; k++)
+          for (size_t j = 0; j < vertices; j++)
+            indices[k][j] = (bits[k * words_per_row + j / kWordBits] >>
+                             (j % kWordBits)) &
+                            1;
+        std::vector<uint64_t>().swap(bits);
+        packed = false;
+      }
+      indices[i] = row;
+    }
+    stats.Set(&AlgorithmStats::parse_microseconds,
+              stats.GetMicroseconds(parse_start));
     file.close();
+    vertices_ = vertices;
+    words_per_row_ = words_per_row;
+    packed_ = packed;
+    bits_.swap(bits);
+    indices_.swap(indices);
     SetType();
+    original_.resize(vertices_);
+    for (size_t i = 0; i < vertices_; i++) original_[i] = i;
+    internal_ = original_;
+    reordered_ = false;
+    version_ = NextVersion();
+    stats.Set(&AlgorithmStats::load_microseconds, stats.GetMicroseconds(start));
   }
 
   void ExportGraphToDot(std::string filename) {
@@ -38,7 +246,7 @@ class Graph {
     for (size_t i = 0, j = 0; i < vertices_; i++) {
       if (!oriented_) j = i;
       for (; j < vertices_; j++)
-        if (indices_[i][j] > 0)
+        if (GetOriginalIndex(i, j) > 0)
           file << "\t" << i + 1 << connection << j + 1 << ";" << std::endl;
     }
     file << "}" << std::endl;
@@ -56,26 +264,264 @@ class Graph {
       std::cout << "Unoriented ";
     std::cout << std::endl;
     for (size_t i = 0; i < vertices_; i++) {
-      for (size_t j = 0; j < vertices_; j++) std::cout << indices_[i][j] << " ";
+      for (size_t j = 0; j < vertices_; j++)
+        std::cout << static_cast<distance_type>(GetOriginalIndex(i, j)) << " ";
       std::cout << std::endl;
     }
   }
 
  private:
+  // Version an index derived from the graph was built for, and the lock for
+  // building it. A copy gets a lock of its own and rebuilds on first use.
+  struct IndexGuard {
+    std::mutex mutex;
+    std::atomic<uint64_t> version{0};
+
+    IndexGuard() = default;
+    IndexGuard(const IndexGuard &) {}
+    IndexGuard &operator=(const IndexGuard &) {
+      version.store(0, std::memory_order_relaxed);
+      return *this;
+    }
+  };
+
   size_t vertices_;
-  std::vector<std::vector<int>> indices_;
+  size_t words_per_row_;
+  std::vector<std::vector<T>> indices_;
+  std::vector<uint64_t> bits_;
   bool weighted_;
   bool oriented_;
+  bool packed_;
+  bool reordered_;
+  std::vector<size_t> original_;
+  std::vector<size_t> internal_;
+  uint64_t version_;
+  size_t heavy_edges_ = 0;
+  std::vector<size_t> components_;
+  size_t component_count_ = 0;
+  IndexGuard components_guard_;
+  StatsSlot stats_callback_;
+
+  const std::vector<size_t> &GetComponents() {
+    if (components_guard_.version.load(std::memory_order_acquire) == version_)
+      return components_;
+    std::lock_guard<std::mutex> lock(components_guard_.mutex);
+    if (components_guard_.version.load(std::memory_order_relaxed) == version_)
+      return components_;
+    if (oriented_)
+      FindStrongComponents();
+    else
+      FindComponents();
+    components_guard_.version.store(version_, std::memory_order_release);
+    return components_;
+  }
+
+  void FindComponents() {
+    std::vector<size_t> parent(vertices_);
+    for (size_t i = 0; i < vertices_; i++) parent[i] = i;
+    auto find = [&](size_t v) {
+      while (parent[v] != v) v = parent[v] = parent[parent[v]];
+      return v;
+    };
+    for (size_t i = 0; i < vertices_; i++)
+      for (size_t j = GetNextNeighbor(i, i + 1); j < vertices_;
+           j = GetNextNeighbor(i, j + 1))
+        parent[find(i)] = find(j);
+    components_.assign(vertices_, vertices_);
+    component_count_ = 0;
+    for (size_t i = 0; i < vertices_; i++) {
+      size_t root = find(i);
+      if (components_[root] == vertices_)
+        components_[root] = component_count_++;
+      components_[i] = components_[root];
+    }
+  }
+
+  // Iterative Tarjan: every stack frame keeps the next neighbour to look at.
+  void FindStrongComponents() {
+    std::vector<size_t> index(vertices_, vertices_), low(vertices_),
+        next(vertices_), frames, members;
+    std::vector<bool> on_stack(vertices_, false);
+    components_.assign(vertices_, 0);
+    component_count_ = 0;
+    size_t counter = 0;
+    for (size_t root = 0; root < vertices_; root++) {
+      if (index[root] != vertices_) continue;
+      frames.push_back(root);
+      while (!frames.empty()) {
+        size_t v = frames.back();
+        if (index[v] == vertices_) {
+          index[v] = low[v] = counter++;
+          next[v] = GetNextNeighbor(v, 0);
+          members.push_back(v);
+          on_stack[v] = true;
+        }
+        if (next[v] < vertices_) {
+          size_t w = next[v];
+          next[v] = GetNextNeighbor(v, w + 1);
+          if (index[w] == vertices_)
+            frames.push_back(w);
+          else if (on_stack[w])
+            low[v] = std::min(low[v], index[w]);
+          continue;
+        }
+        frames.pop_back();
+        if (!frames.empty())
+          low[frames.back()] = std::min(low[frames.back()], low[v]);
+        if (low[v] != index[v]) continue;
+        size_t w;
+        do {
+          w = members.back();
+          members.pop_back();
+          on_stack[w] = false;
+          components_[w] = component_count_;
+        } while (w != v);
+        component_count_++;
+      }
+    }
+  }
+
+  static uint64_t NextVersion() {
+    static std::atomic<uint64_t> counter(0);
+    return ++counter;
+  }
+
+  T GetOriginalIndex(size_t i, size_t j) const {
+    return GetIndex(internal_[i], internal_[j]);
+  }
 
   void SetType() {
-    weighted_ = false;
+    heavy_edges_ = 0;
     oriented_ = false;
     for (size_t i = 0; i < vertices_; i++)
       for (size_t j = 0; j < vertices_; j++) {
-        if (indices_[i][j] != indices_[j][i]) oriented_ = true;
-        if (indices_[i][j] > 1) weighted_ = true;
+        if (i < j && GetIndex(i, j) != GetIndex(j, i)) oriented_ = true;
+        if (GetIndex(i, j) > 1) heavy_edges_++;
       }
+    weighted_ = heavy_edges_ > 0;
+  }
+
+  void CheckVertices(size_t vertex1, size_t vertex2) const {
+    if (vertex1 < 1 || vertex1 > vertices_ || vertex2 < 1 ||
+        vertex2 > vertices_)
+      throw std::exception();
+  }
+
+  // Stores one entry and keeps the counter behind weighted_.
+  void Write(size_t i, size_t j, T weight) {
+    if (GetIndex(i, j) > 1) heavy_edges_--;
+    if (packed_) {
+      uint64_t &word = bits_[i * words_per_row_ + j / kWordBits];
+      uint64_t bit = uint64_t(1) << (j % kWordBits);
+      word = weight != 0 ? word | bit : word & ~bit;
+    } else {
+      indices_[i][j] = weight;
+    }
+    if (weight > 1) heavy_edges_++;
+  }
+
+  void Unpack() {
+    indices_ = std::vector(vertices_, std::vector<T>(vertices_));
+    for (size_t i = 0; i < vertices_; i++)
+      for (size_t j = 0; j < vertices_; j++) indices_[i][j] = GetIndex(i, j);
+    packed_ = false;
+    std::vector<uint64_t>().swap(bits_);
+  }
+
+  // Sets the bits of a packed row for the entries of row that are 1. Returns
+  // false, writing nothing, when row holds a value other than 0 and 1.
+  static bool PackRow(const std::vector<T> &row, uint64_t *bits) {
+    for (T weight : row)
+      if (weight != 0 && weight != 1) return false;
+    for (size_t j = 0; j < row.size(); j++)
+      if (row[j] == 1) bits[j / kWordBits] |= uint64_t(1) << (j % kWordBits);
+    return true;
+  }
+
+  std::vector<std::vector<size_t>> GetUndirectedNeighbors() const {
+    std::vector<std::vector<size_t>> neighbors(vertices_);
+    for (size_t i = 0; i < vertices_; i++)
+      for (size_t j = 0; j < vertices_; j++)
+        if (i != j && (GetIndex(i, j) > 0 || GetIndex(j, i) > 0))
+          neighbors[i].push_back(j);
+    return neighbors;
+  }
+
+  std::vector<size_t> GetDegreeOrder(
+      const std::vector<std::vector<size_t>> &neighbors) const {
+    std::vector<size_t> order(vertices_);
+    for (size_t i = 0; i < vertices_; i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return neighbors[a].size() > neighbors[b].size();
+    });
+    return order;
+  }
+
+  // Every component is traversed from its lowest degree vertex; Cuthill-McKee
+  // also visits neighbours by ascending degree and the result is reversed.
+  std::vector<size_t> GetBreadthFirstOrder(
+      std::vector<std::vector<size_t>> &neighbors, bool cuthill_mckee) const {
+    auto by_degree = [&](size_t a, size_t b) {
+      return neighbors[a].size() < neighbors[b].size();
+    };
+    std::vector<size_t> roots(vertices_), order;
+    for (size_t i = 0; i < vertices_; i++) roots[i] = i;
+    std::stable_sort(roots.begin(), roots.end(), by_degree);
+    if (cuthill_mckee)
+      for (std::vector<size_t> &list : neighbors)
+        std::stable_sort(list.begin(), list.end(), by_degree);
+    std::vector<bool> visited(vertices_, false);
+    for (size_t root : roots) {
+      if (visited[root]) continue;
+      visited[root] = true;
+      size_t head = order.size();
+      order.push_back(root);
+      for (; head < order.size(); head++)
+        for (size_t neighbor : neighbors[order[head]])
+          if (!visited[neighbor]) {
+            visited[neighbor] = true;
+            order.push_back(neighbor);
+          }
+    }
+    if (cuthill_mckee) std::reverse(order.begin(), order.end());
+    return order;
+  }
+
+  // Moves the vertex at internal position order[k] to position k.
+  void Permute(const std::vector<size_t> &order) {
+    std::vector<size_t> position(vertices_);
+    for (size_t k = 0; k < vertices_; k++) position[order[k]] = k;
+    if (packed_) {
+      std::vector<uint64_t> bits(bits_.size(), 0);
+      for (size_t k = 0; k < vertices_; k++) {
+        const uint64_t *row = GetAdjacencyRow(order[k]);
+        for (size_t w = 0; w < words_per_row_; w++)
+          for (uint64_t word = row[w]; word; word &= word - 1) {
+            size_t j = position[w * kWordBits + __builtin_ctzll(word)];
+            bits[k * words_per_row_ + j / kWordBits] |= uint64_t(1)
+                                                        << (j % kWordBits);
+          }
+      }
+      bits_.swap(bits);
+    } else {
+      std::vector<std::vector<T>> indices(vertices_, std::vector<T>(vertices_));
+      for (size_t k = 0; k < vertices_; k++)
+        for (size_t l = 0; l < vertices_; l++)
+          indices[k][l] = indices_[order[k]][order[l]];
+      indices_.swap(indices);
+    }
+    std::vector<size_t> original(vertices_);
+    for (size_t k = 0; k < vertices_; k++) original[k] = original_[order[k]];
+    original_.swap(original);
+    for (size_t k = 0; k < vertices_; k++) internal_[original_[k]] = k;
+    reordered_ = true;
+    version_ = NextVersion();
   }
 };
 
+using Graph = BasicGraph<int>;
+using Graph8 = BasicGraph<uint8_t>;
+using Graph16 = BasicGraph<uint16_t>;
+using GraphF = BasicGraph<float>;
 }  // namespace s21
+#endif  // SRC_S21_GRAPH_H_
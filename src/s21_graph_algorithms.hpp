@@ -1,37 +1,76 @@
+#ifndef SRC_S21_GRAPH_ALGORITHMS_H_
+#define SRC_S21_GRAPH_ALGORITHMS_H_
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <exception>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <utility>
+#include <variant>
 
 #include "s21_ant_colony.hpp"
+#include "s21_query_cache.hpp"
 #include "s21_queue.hpp"
 #include "s21_stack.hpp"
+#include "s21_task_control.hpp"
+#include "s21_thread_pool.hpp"
 
 namespace s21 {
-class GraphAlgorithms {
+template <typename T>
+class BasicGraphAlgorithms {
  public:
-  s21::Stack<int> DepthFirstSearch(s21::Graph &graph, size_t start_vertex) {
+  using Graph = BasicGraph<T>;
+  using distance_type = typename WeightTraits<T>::distance_type;
+
+  // Keeps up to capacity_bytes of distances, shortest path trees, all-pairs
+  // matrices and spanning trees, keyed by the graph version.
+  void EnableCache(size_t capacity_bytes) {
+    cache_ = std::make_shared<QueryCache<CachedValue>>(capacity_bytes);
+  }
+
+  void DisableCache() { cache_.reset(); }
+
+  CacheStats GetCacheStats() const {
+    return cache_ ? cache_->GetStats() : CacheStats();
+  }
+
+  // Called with the counters of every call when built with S21_STATS; the
+  // callback may run on several threads at once.
+  void SetStatsCallback(StatsCallback callback) {
+    stats_callback_.Set(std::move(callback));
+  }
+
+  s21::Stack<int> DepthFirstSearch(Graph &graph, size_t start_vertex) {
     if (start_vertex < 1 || start_vertex > graph.GetVertices() ||
         graph.GetVertices() < 2)
       throw std::exception();
+    StatsScope stats(stats_callback_, "DepthFirstSearch");
     s21::Stack<int> res, temp;
     std::vector<bool> visited(graph.GetVertices(), false);
+    size_t start = ToInternal(graph, start_vertex);
     res.push(start_vertex);
-    temp.push(start_vertex - 1);
-    visited[start_vertex - 1] = true;
+    temp.push(start);
+    visited[start] = true;
+    if (graph.IsPacked() && !graph.IsReordered()) {
+      PackedDepthFirstSearch(graph, res, temp);
+      return res;
+    }
     while (!temp.empty()) {
       int position = temp.top();
       size_t neighbor = 0;
-      for (; neighbor < graph.GetVertices(); neighbor++)
-        if (graph.GetIndex(position, neighbor) > 0 &&
-            visited[neighbor] == false) {
-          visited[neighbor] = true;
-          temp.push(neighbor);
+      for (; neighbor < graph.GetVertices(); neighbor++) {
+        size_t next = graph.GetInternalVertex(neighbor);
+        if (graph.GetIndex(position, next) > 0 && visited[next] == false) {
+          visited[next] = true;
+          temp.push(next);
           res.push(neighbor + 1);
           break;
         }
+      }
       if (neighbor == graph.GetVertices()) temp.pop();
     }
     return res;
@@ -41,105 +80,514 @@ class GraphAlgorithms {
     if (start_vertex < 1 || start_vertex > graph.GetVertices() ||
         graph.GetVertices() < 2)
       throw std::exception();
+    StatsScope stats(stats_callback_, "BreadthFirstSearch");
     s21::Queue<int> res, temp;
     std::vector<bool> visited(graph.GetVertices(), false);
+    size_t start = ToInternal(graph, start_vertex);
     res.push(start_vertex);
-    temp.push(start_vertex - 1);
-    visited[start_vertex - 1] = true;
+    temp.push(start);
+    visited[start] = true;
+    if (graph.IsPacked() && !graph.IsReordered()) {
+      PackedBreadthFirstSearch(graph, res, temp);
+      return res;
+    }
     while (!temp.empty()) {
       int position = temp.front();
       temp.pop();
-      for (size_t i = 0; i < graph.GetVertices(); i++)
-        if (graph.GetIndex(position, i) > 0 && visited[i] == false) {
-          visited[i] = true;
+      for (size_t i = 0; i < graph.GetVertices(); i++) {
+        size_t next = graph.GetInternalVertex(i);
+        if (graph.GetIndex(position, next) > 0 && visited[next] == false) {
+          visited[next] = true;
           res.push(i + 1);
-          temp.push(i);
+          temp.push(next);
         }
+      }
     }
     return res;
   }
 
-  int GetShortestPathBetweenVertices(Graph &graph, size_t vertex1,
-                                     size_t vertex2) {
+  std::vector<std::vector<int>> GetHopDistancesFromVertices(
+      Graph &graph, const std::vector<size_t> &start_vertices) {
+    if (graph.GetVertices() < 2) throw std::exception();
+    for (size_t start_vertex : start_vertices)
+      if (start_vertex < 1 || start_vertex > graph.GetVertices())
+        throw std::exception();
+    StatsScope stats(stats_callback_, "GetHopDistancesFromVertices");
+    std::vector<std::vector<int>> res(
+        start_vertices.size(),
+        std::vector<int>(graph.GetVertices(), kUnreachedHop));
+    for (size_t batch = 0; batch < start_vertices.size(); batch += kBatchSize)
+      BatchBreadthFirstSearch(graph, start_vertices, batch, res);
+    return res;
+  }
+
+  distance_type GetShortestPathBetweenVertices(Graph &graph, size_t vertex1,
+                                               size_t vertex2) {
     if (vertex1 < 1 || vertex1 > graph.GetVertices() || vertex2 < 1 ||
         vertex2 > graph.GetVertices() || graph.GetVertices() < 2)
       throw std::exception();
-    std::vector<bool> visited(graph.GetVertices(), false);
-    std::vector<int> vertexes_values(graph.GetVertices(), kMaxValue);
-    int position = vertex1 - 1, target = vertex2 - 1;
-    vertexes_values[position] = 0;
-    while (true) {
-      visited[position] = true;
-      for (size_t i = 0; i < graph.GetVertices(); i++)
-        if (graph.GetIndex(position, i) > 0 && visited[i] == false &&
-            vertexes_values[i] >
-                vertexes_values[position] + graph.GetIndex(position, i))
-          vertexes_values[i] =
-              vertexes_values[position] + graph.GetIndex(position, i);
-      int shortest_way = kMaxValue, next_vertex = -1;
-      for (size_t i = 0; i < graph.GetVertices(); i++)
-        if (graph.GetIndex(position, i) > 0 && visited[i] == false &&
-            vertexes_values[i] < shortest_way) {
-          shortest_way = vertexes_values[i];
-          next_vertex = i;
-        }
-      if (next_vertex == -1 || next_vertex == target) break;
-      position = next_vertex;
-    }
-    return vertexes_values[target];
+    StatsScope stats(stats_callback_, "GetShortestPathBetweenVertices");
+    if (std::shared_ptr<const CachedValue> cached =
+            FindCached(graph, kDistance, vertex1, vertex2))
+      return std::get<kDistance>(*cached);
+    if (graph.IsUnreachable(vertex1, vertex2)) return kMaxValue;
+    Workspace workspace;
+    size_t target = ToInternal(graph, vertex2);
+    workspace.targets.push_back(target);
+    SearchShortestPaths(graph, ToInternal(graph, vertex1), workspace, stats);
+    return StoreCached<kDistance>(graph, vertex1, vertex2,
+                                  workspace.vertexes_values[target]);
   }
 
-  std::vector<std::vector<int>> GetShortestPathsBetweenAllVertices(
-      Graph &graph) {
+  // Distances from start_vertex to every vertex, indexed from 0.
+  std::vector<distance_type> GetShortestPathsFromVertex(Graph &graph,
+                                                        size_t start_vertex) {
+    if (start_vertex < 1 || start_vertex > graph.GetVertices() ||
+        graph.GetVertices() < 2)
+      throw std::exception();
+    StatsScope stats(stats_callback_, "GetShortestPathsFromVertex");
+    if (std::shared_ptr<const CachedValue> cached =
+            FindCached(graph, kShortestPathTree, start_vertex, 0))
+      return std::get<kShortestPathTree>(*cached);
+    Workspace workspace;
+    SearchShortestPaths(graph, ToInternal(graph, start_vertex), workspace,
+                        stats);
+    std::vector<distance_type> res(graph.GetVertices());
+    for (size_t i = 0; i < graph.GetVertices(); i++)
+      res[graph.GetOriginalVertex(i)] = workspace.vertexes_values[i];
+    return StoreCached<kShortestPathTree>(graph, start_vertex, 0,
+                                          std::move(res));
+  }
+
+  // Answers every (source, target) pair, in input order. Pairs sharing a
+  // source are served by one search; sources run on the shared thread pool.
+  std::vector<distance_type> GetShortestPathsBetweenPairs(
+      Graph &graph, const std::vector<std::pair<size_t, size_t>> &pairs) {
     if (graph.GetVertices() < 2) throw std::exception();
-    std::vector<std::vector<int>> res(graph.GetVertices(),
-                                      std::vector<int>(graph.GetVertices()));
+    for (const std::pair<size_t, size_t> &pair : pairs)
+      if (pair.first < 1 || pair.first > graph.GetVertices() ||
+          pair.second < 1 || pair.second > graph.GetVertices())
+        throw std::exception();
+    StatsScope stats(stats_callback_, "GetShortestPathsBetweenPairs");
+    std::vector<distance_type> res(pairs.size(), kMaxValue);
+    std::vector<size_t> order, groups;
+    for (size_t i = 0; i < pairs.size(); i++)
+      if (!graph.IsUnreachable(pairs[i].first, pairs[i].second))
+        order.push_back(i);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return pairs[a].first < pairs[b].first;
+    });
+    for (size_t i = 0; i < order.size(); i++)
+      if (i == 0 || pairs[order[i]].first != pairs[order[i - 1]].first)
+        groups.push_back(i);
+    groups.push_back(order.size());
+    ThreadPool &pool = ThreadPool::Shared();
+    std::vector<Workspace> workspaces(pool.GetThreads());
+    // Workers count into scopes of their own, merged below. Without
+    // S21_STATS there is nothing to count, so none are allocated.
+    std::vector<StatsScope> worker_stats(kStatsEnabled ? pool.GetThreads()
+                                                       : 0);
+    pool.ParallelFor(groups.size() - 1, [&](size_t worker, size_t group) {
+      if (std::shared_ptr<const CachedValue> cached = FindCached(
+              graph, kShortestPathTree, pairs[order[groups[group]]].first, 0)) {
+        for (size_t i = groups[group]; i < groups[group + 1]; i++)
+          res[order[i]] =
+              std::get<kShortestPathTree>(*cached)[pairs[order[i]].second - 1];
+        return;
+      }
+      Workspace &workspace = workspaces[worker];
+      workspace.targets.clear();
+      for (size_t i = groups[group]; i < groups[group + 1]; i++)
+        workspace.targets.push_back(
+            ToInternal(graph, pairs[order[i]].second));
+      SearchShortestPaths(
+          graph, ToInternal(graph, pairs[order[groups[group]]].first),
+          workspace, kStatsEnabled ? worker_stats[worker] : stats);
+      for (size_t i = groups[group]; i < groups[group + 1]; i++)
+        res[order[i]] = workspace.vertexes_values
+                            [workspace.targets[i - groups[group]]];
+    });
+    for (const StatsScope &worker : worker_stats) stats.Merge(worker);
+    return res;
+  }
+
+  // The long-running methods below accept a TaskControl, checked once per
+  // pivot (Floyd-Warshall), added vertex (Prim) or colony iteration. A
+  // cancelled all-pairs or spanning tree search throws OperationCancelled.
+  std::vector<std::vector<distance_type>> GetShortestPathsBetweenAllVertices(
+      Graph &graph, const TaskControl &control = TaskControl()) {
+    return *GetSharedShortestPathsBetweenAllVertices(graph, control);
+  }
+
+  std::vector<std::vector<T>> GetLeastSpanningTree(
+      Graph &graph, const TaskControl &control = TaskControl()) {
+    return *GetSharedLeastSpanningTree(graph, control);
+  }
+
+  // The same matrices without a copy: a cache hit hands out the cached
+  // matrix itself, and a computed one is moved into the cache.
+  std::shared_ptr<const std::vector<std::vector<distance_type>>>
+  GetSharedShortestPathsBetweenAllVertices(
+      Graph &graph, const TaskControl &control = TaskControl()) {
+    if (graph.GetVertices() < 2) throw std::exception();
+    StatsScope stats(stats_callback_, "GetShortestPathsBetweenAllVertices");
+    if (std::shared_ptr<const CachedValue> cached =
+            FindCached(graph, kAllPaths, 0, 0))
+      return GetShared<kAllPaths>(std::move(cached));
+    std::vector<std::vector<distance_type>> res(
+        graph.GetVertices(), std::vector<distance_type>(graph.GetVertices()));
     for (size_t i = 0; i < graph.GetVertices(); i++)
       for (size_t j = 0; j < graph.GetVertices(); j++)
         res[i][j] = graph.GetIndex(i, j);
 
-    for (size_t i = 0; i < graph.GetVertices(); i++)
-      for (size_t j = 0; j < graph.GetVertices(); j++)
+    // Intermediate vertices go in the original order, so the result does not
+    // depend on how the graph is stored internally.
+    for (size_t vertex = 0; vertex < graph.GetVertices(); vertex++) {
+      if (control.IsCancelled()) throw OperationCancelled();
+      for (size_t j = 0, i = graph.GetInternalVertex(vertex);
+           j < graph.GetVertices(); j++)
         for (size_t k = 0; k < graph.GetVertices(); k++)
-          if (graph.GetIndex(j, i) > 0 && graph.GetIndex(i, k) > 0)
-            res[j][k] = std::min(graph.GetIndex(j, k),
-                                 graph.GetIndex(j, i) + graph.GetIndex(i, k));
-    return res;
+          if (graph.GetIndex(j, i) > 0 && graph.GetIndex(i, k) > 0) {
+            stats.Add(&AlgorithmStats::relaxations);
+            res[j][k] = std::min<distance_type>(
+                graph.GetIndex(j, k),
+                Add(graph.GetIndex(j, i), graph.GetIndex(i, k)));
+          }
+      control.Report(vertex + 1, graph.GetVertices());
+    }
+    return StoreShared<kAllPaths>(graph, ToOriginalOrder(graph, res));
   }
 
-  std::vector<std::vector<int>> GetLeastSpanningTree(Graph &graph) {
+  std::shared_ptr<const std::vector<std::vector<T>>> GetSharedLeastSpanningTree(
+      Graph &graph, const TaskControl &control = TaskControl()) {
     if (graph.GetVertices() < 2) throw std::exception();
-    std::vector<std::vector<int>> res(graph.GetVertices(),
-                                      std::vector<int>(graph.GetVertices()));
+    StatsScope stats(stats_callback_, "GetLeastSpanningTree");
+    if (std::shared_ptr<const CachedValue> cached =
+            FindCached(graph, kSpanningTree, 0, 0))
+      return GetShared<kSpanningTree>(std::move(cached));
+    std::vector<std::vector<T>> res(graph.GetVertices(),
+                                    std::vector<T>(graph.GetVertices()));
     std::vector<bool> visited(graph.GetVertices(), false);
-    int from = 0, position = 0;
+    // Vertices are scanned in the original order, so the start vertex and
+    // the choice between equal weights do not depend on the storage order.
+    size_t from = graph.GetInternalVertex(0), position = from;
     for (size_t i = 0; i < graph.GetVertices(); i++) {
-      int minimal_weight = kMaxValue;
+      if (control.IsCancelled()) throw OperationCancelled();
+      distance_type minimal_weight = kMaxValue;
       visited[position] = true;
-      for (size_t j = 0; j < graph.GetVertices(); j++)
-        for (size_t k = 0; k < graph.GetVertices(); k++)
-          if (visited[j] && !visited[k] && graph.GetIndex(j, k) > 0 &&
-              graph.GetIndex(j, k) < minimal_weight) {
-            minimal_weight = graph.GetIndex(j, k);
-            from = j;
-            position = k;
+      stats.Add(&AlgorithmStats::vertices_settled);
+      for (size_t j = 0; j < graph.GetVertices(); j++) {
+        size_t u = graph.GetInternalVertex(j);
+        if (!visited[u]) continue;
+        for (size_t k = 0; k < graph.GetVertices(); k++) {
+          size_t v = graph.GetInternalVertex(k);
+          if (!visited[v] && graph.GetIndex(u, v) > 0) {
+            stats.Add(&AlgorithmStats::edges_relaxed);
+            if (graph.GetIndex(u, v) < minimal_weight) {
+              minimal_weight = graph.GetIndex(u, v);
+              from = u;
+              position = v;
+            }
           }
+        }
+      }
       res[from][position] = res[position][from] =
           graph.GetIndex(from, position);
+      control.Report(i + 1, graph.GetVertices());
     }
-    return res;
+    return StoreShared<kSpanningTree>(graph, ToOriginalOrder(graph, res));
   }
 
-  TsmResult SolveTravelingSalesmanProblem(Graph &graph) {
+  // A cancelled run returns the best tour found so far.
+  TsmResult SolveTravelingSalesmanProblem(
+      Graph &graph, const TaskControl &control = TaskControl()) {
     if (graph.GetVertices() < 2) throw std::exception();
+    StatsScope stats(stats_callback_, "SolveTravelingSalesmanProblem");
+    // A tour through every vertex needs one (strongly) connected component.
+    if (graph.GetComponentCount() > 1) return TsmResult();
     double alfa = 1.0, beta = 4.0, pheromon_level = 100.0, evaporation = 0.5;
     size_t number_of_ants = 10, iterations = 100;
     AntColony aco(number_of_ants, graph.GetVertices(), alfa, beta,
                   pheromon_level, evaporation);
-    return aco.AntAnlgorithm(graph, iterations);
+    return ToOriginalTour(
+        graph, aco.AntAnlgorithm(graph, iterations, stats, control));
+  }
+
+  // Run the methods above on a thread of their own. The graph and this
+  // object must outlive the future, and the graph must not change meanwhile.
+  std::future<std::vector<std::vector<distance_type>>>
+  GetShortestPathsBetweenAllVerticesAsync(Graph &graph,
+                                          TaskControl control = TaskControl()) {
+    return std::async(std::launch::async, [this, &graph, control] {
+      return GetShortestPathsBetweenAllVertices(graph, control);
+    });
+  }
+
+  std::future<std::vector<std::vector<T>>> GetLeastSpanningTreeAsync(
+      Graph &graph, TaskControl control = TaskControl()) {
+    return std::async(std::launch::async, [this, &graph, control] {
+      return GetLeastSpanningTree(graph, control);
+    });
+  }
+
+  std::future<TsmResult> SolveTravelingSalesmanProblemAsync(
+      Graph &graph, TaskControl control = TaskControl()) {
+    return std::async(std::launch::async, [this, &graph, control] {
+      return SolveTravelingSalesmanProblem(graph, control);
+    });
   }
 
  private:
-  const int kMaxValue = std::numeric_limits<int>::max();
+  // Alternatives are listed in CacheKind order; distance_type and T may be
+  // the same type, so they are always accessed by index.
+  enum CacheKind { kDistance, kShortestPathTree, kAllPaths, kSpanningTree };
+  using CachedValue =
+      std::variant<distance_type, std::vector<distance_type>,
+                   std::vector<std::vector<distance_type>>,
+                   std::vector<std::vector<T>>>;
+
+  std::shared_ptr<QueryCache<CachedValue>> cache_;
+  StatsSlot stats_callback_;
+  const distance_type kMaxValue = WeightTraits<T>::Infinity();
+  const int kUnreachedHop = std::numeric_limits<int>::max();
+  static constexpr size_t kBatchSize = 64;
+
+  static distance_type Add(distance_type a, distance_type b) {
+    return WeightTraits<T>::Add(a, b);
+  }
+
+  std::shared_ptr<const CachedValue> FindCached(const Graph &graph,
+                                                CacheKind kind, size_t first,
+                                                size_t second) {
+    if (!cache_) return nullptr;
+    return cache_->Find(CacheKey{graph.GetVersion(), kind, first, second});
+  }
+
+  template <size_t Kind, typename Result>
+  Result StoreCached(const Graph &graph, size_t first, size_t second,
+                     Result result) {
+    if (!cache_) return result;
+    cache_->Insert(
+        CacheKey{graph.GetVersion(), int(Kind), first, second},
+        std::make_shared<const CachedValue>(std::in_place_index<Kind>, result),
+        sizeof(CachedValue) + GetBytes(result));
+    return result;
+  }
+
+  // Points into the variant held by cached and keeps it alive.
+  template <size_t Kind>
+  static auto GetShared(std::shared_ptr<const CachedValue> cached) {
+    using Result = std::variant_alternative_t<Kind, CachedValue>;
+    const Result *result = &std::get<Kind>(*cached);
+    return std::shared_ptr<const Result>(std::move(cached), result);
+  }
+
+  // Moves a matrix-valued result into the cache, or into a pointer of its
+  // own when the cache is off.
+  template <size_t Kind, typename Result>
+  std::shared_ptr<const Result> StoreShared(const Graph &graph,
+                                            Result result) {
+    size_t bytes = sizeof(CachedValue) + GetBytes(result);
+    std::shared_ptr<const CachedValue> value =
+        std::make_shared<const CachedValue>(std::in_place_index<Kind>,
+                                            std::move(result));
+    if (cache_)
+      cache_->Insert(CacheKey{graph.GetVersion(), int(Kind), 0, 0}, value,
+                     bytes);
+    return GetShared<Kind>(std::move(value));
+  }
+
+  static size_t GetBytes(const distance_type &) { return 0; }
+
+  template <typename V>
+  static size_t GetBytes(const std::vector<V> &values) {
+    size_t bytes = values.capacity() * sizeof(V);
+    for (const V &value : values) bytes += GetBytes(value);
+    return bytes;
+  }
+
+  // Buffers of one Dijkstra run, kept by each pool worker between searches.
+  struct Workspace {
+    std::vector<bool> visited;
+    std::vector<bool> wanted;
+    std::vector<distance_type> vertexes_values;
+    std::vector<size_t> targets;
+  };
+
+  // Array-based Dijkstra (the graph is a dense matrix) from an internal
+  // position; stops once every target is settled, or covers the whole
+  // component when there are no targets.
+  void SearchShortestPaths(const Graph &graph, size_t position,
+                           Workspace &workspace, StatsScope &stats) {
+    size_t size = graph.GetVertices(), left = 0;
+    workspace.visited.assign(size, false);
+    workspace.wanted.assign(size, false);
+    workspace.vertexes_values.assign(size, kMaxValue);
+    for (size_t target : workspace.targets)
+      if (!workspace.wanted[target]) {
+        workspace.wanted[target] = true;
+        left++;
+      }
+    bool everything = left == 0;
+    workspace.vertexes_values[position] = 0;
+    while (true) {
+      workspace.visited[position] = true;
+      stats.Add(&AlgorithmStats::vertices_settled);
+      if (!everything && workspace.wanted[position] && --left == 0) break;
+      ForEachNeighbor(graph, position, [&](size_t i) {
+        stats.Add(&AlgorithmStats::edges_relaxed);
+        distance_type way = Add(workspace.vertexes_values[position],
+                                graph.GetIndex(position, i));
+        if (!workspace.visited[i] && way < workspace.vertexes_values[i])
+          workspace.vertexes_values[i] = way;
+      });
+      distance_type shortest_way = kMaxValue;
+      for (size_t i = 0; i < size; i++)
+        if (!workspace.visited[i] &&
+            workspace.vertexes_values[i] < shortest_way) {
+          shortest_way = workspace.vertexes_values[i];
+          position = i;
+        }
+      if (shortest_way == kMaxValue) break;
+    }
+  }
+
+  // Callers number vertices from 1 in the original order, while the graph may
+  // keep them in a different internal order (see BasicGraph::Reorder).
+  size_t ToInternal(const Graph &graph, size_t vertex) {
+    return graph.GetInternalVertex(vertex - 1);
+  }
+
+  int ToExternal(const Graph &graph, size_t position) {
+    return graph.GetOriginalVertex(position) + 1;
+  }
+
+  template <typename V>
+  std::vector<std::vector<V>> ToOriginalOrder(
+      const Graph &graph, std::vector<std::vector<V>> &matrix) {
+    if (!graph.IsReordered()) return std::move(matrix);
+    std::vector<std::vector<V>> res(matrix.size(),
+                                    std::vector<V>(matrix.size()));
+    for (size_t i = 0; i < matrix.size(); i++)
+      for (size_t j = 0; j < matrix.size(); j++)
+        res[graph.GetOriginalVertex(i)][graph.GetOriginalVertex(j)] =
+            matrix[i][j];
+    return res;
+  }
+
+  TsmResult ToOriginalTour(const Graph &graph, TsmResult result) {
+    if (!graph.IsReordered() || result.vertices.empty()) return result;
+    result.vertices.pop_back();
+    for (int &vertex : result.vertices)
+      vertex = ToExternal(graph, vertex - 1);
+    std::rotate(result.vertices.begin(),
+                std::find(result.vertices.begin(), result.vertices.end(), 1),
+                result.vertices.end());
+    result.vertices.push_back(result.vertices.front());
+    return result;
+  }
+
+  template <typename Function>
+  void ForEachNeighbor(const Graph &graph, size_t position, Function f) {
+    if (graph.IsPacked()) {
+      const uint64_t *row = graph.GetAdjacencyRow(position);
+      for (size_t w = 0; w < graph.GetWordsPerRow(); w++)
+        for (uint64_t bits = row[w]; bits; bits &= bits - 1)
+          f(w * Graph::kWordBits + __builtin_ctzll(bits));
+    } else {
+      for (size_t i = 0; i < graph.GetVertices(); i++)
+        if (graph.GetIndex(position, i) > 0) f(i);
+    }
+  }
+
+  // On a bit matrix the unvisited neighbours of a vertex are row & ~visited,
+  // scanned a word at a time. Bits follow the internal order, so these are
+  // used only when it is the original one.
+  void PackedDepthFirstSearch(const Graph &graph, s21::Stack<int> &res,
+                              s21::Stack<int> &temp) {
+    size_t words = graph.GetWordsPerRow();
+    std::vector<uint64_t> visited(words, 0);
+    visited[temp.top() / Graph::kWordBits] |=
+        uint64_t(1) << (temp.top() % Graph::kWordBits);
+    while (!temp.empty()) {
+      const uint64_t *row = graph.GetAdjacencyRow(temp.top());
+      size_t w = 0;
+      while (w < words && (row[w] & ~visited[w]) == 0) w++;
+      if (w == words) {
+        temp.pop();
+        continue;
+      }
+      uint64_t bit = (row[w] & ~visited[w]) & -(row[w] & ~visited[w]);
+      int neighbor = w * Graph::kWordBits + __builtin_ctzll(bit);
+      visited[w] |= bit;
+      temp.push(neighbor);
+      res.push(ToExternal(graph, neighbor));
+    }
+  }
+
+  void PackedBreadthFirstSearch(const Graph &graph, s21::Queue<int> &res,
+                                s21::Queue<int> &temp) {
+    size_t words = graph.GetWordsPerRow();
+    std::vector<uint64_t> visited(words, 0);
+    visited[temp.front() / Graph::kWordBits] |=
+        uint64_t(1) << (temp.front() % Graph::kWordBits);
+    while (!temp.empty()) {
+      const uint64_t *row = graph.GetAdjacencyRow(temp.front());
+      temp.pop();
+      for (size_t w = 0; w < words; w++) {
+        uint64_t fresh = row[w] & ~visited[w];
+        visited[w] |= fresh;
+        for (; fresh; fresh &= fresh - 1) {
+          int neighbor = w * Graph::kWordBits + __builtin_ctzll(fresh);
+          res.push(ToExternal(graph, neighbor));
+          temp.push(neighbor);
+        }
+      }
+    }
+  }
+
+  // Multi-source BFS: every vertex keeps a 64-bit mask of the searches that
+  // have reached it, so one sweep over the matrix advances the whole batch.
+  void BatchBreadthFirstSearch(Graph &graph,
+                               const std::vector<size_t> &start_vertices,
+                               size_t batch,
+                               std::vector<std::vector<int>> &res) {
+    size_t size = graph.GetVertices();
+    size_t count = std::min(kBatchSize, start_vertices.size() - batch);
+    std::vector<uint64_t> seen(size, 0), visit(size, 0), visit_next(size, 0);
+    for (size_t i = 0; i < count; i++) {
+      size_t position = ToInternal(graph, start_vertices[batch + i]);
+      seen[position] |= uint64_t(1) << i;
+      visit[position] |= uint64_t(1) << i;
+      res[batch + i][start_vertices[batch + i] - 1] = 0;
+    }
+    bool active = true;
+    for (int level = 1; active; level++) {
+      active = false;
+      for (size_t position = 0; position < size; position++) {
+        if (visit[position] == 0) continue;
+        ForEachNeighbor(graph, position, [&](size_t i) {
+          uint64_t reached = visit[position] & ~seen[i];
+          if (reached == 0) return;
+          visit_next[i] |= reached;
+          seen[i] |= reached;
+          active = true;
+        });
+      }
+      for (size_t position = 0; position < size; position++) {
+        size_t vertex = graph.GetOriginalVertex(position);
+        for (uint64_t bits = visit_next[position]; bits; bits &= bits - 1)
+          res[batch + __builtin_ctzll(bits)][vertex] = level;
+        visit[position] = visit_next[position];
+        visit_next[position] = 0;
+      }
+    }
+  }
 };
-}  // namespace s21
\ No newline at end of file
+
+using GraphAlgorithms = BasicGraphAlgorithms<int>;
+using GraphAlgorithms8 = BasicGraphAlgorithms<uint8_t>;
+using GraphAlgorithms16 = BasicGraphAlgorithms<uint16_t>;
+using GraphAlgorithmsF = BasicGraphAlgorithms<float>;
+}  // namespace s21
+#endif  // SRC_S21_GRAPH_ALGORITHMS_H_
@@ -1,10 +1,57 @@
+#ifndef SRC_S21_NAVIGATOR_INTERFACE_H_
+#define SRC_S21_NAVIGATOR_INTERFACE_H_
+#include <chrono>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "s21_graph_algorithms.hpp"
+#include "s21_output_format.hpp"
 
 namespace s21 {
 class NavigatorInterface {
  public:
+  enum class OutputFormat { kCsv, kJson };
+
+  NavigatorInterface() = default;
+
+  NavigatorInterface(const NavigatorInterface &) = delete;
+  NavigatorInterface &operator=(const NavigatorInterface &) = delete;
+
+  // Non-interactive mode: reads whitespace separated commands (load FILE,
+  // bfs V, dfs V, sp V1 V2, apsp, mst, tsp) until the end of the script and
+  // writes one CSV row or JSON line per command with its run time. Builds
+  // with S21_STATS add the counters of every algorithm call the command made;
+  // the counters are collected only while the script runs.
+  void RunBatch(std::istream &script, std::ostream &out, OutputFormat format) {
+    if constexpr (kStatsEnabled) {
+      StatsCallback collect = [this](const AlgorithmStats &stats) {
+        stats_.push_back(stats);
+      };
+      graph_.SetStatsCallback(collect);
+      algorithms_.SetStatsCallback(collect);
+    }
+    BufferedWriter writer(out);
+    if (format == OutputFormat::kCsv)
+      writer << "command,arguments,status,microseconds,result"
+             << (kStatsEnabled ? ",stats\n" : "\n");
+    std::string command;
+    while (script >> command) {
+      std::vector<std::string> arguments(GetArity(command));
+      for (std::string &argument : arguments) script >> argument;
+      Record record{writer, format, command, arguments};
+      if (!script && !arguments.empty())
+        WriteRecord(record, false, 0, std::string("missing arguments"));
+      else
+        RunCommand(record);
+    }
+    if constexpr (kStatsEnabled) {
+      graph_.SetStatsCallback(nullptr);
+      algorithms_.SetStatsCallback(nullptr);
+      stats_.clear();
+    }
+  }
+
   void Start() {
     int input = -1;
     while (input != 0) {
@@ -47,6 +94,8 @@ class NavigatorInterface {
  private:
   Graph graph_;
   GraphAlgorithms algorithms_;
+  // Calls made by the current batch command; filled only with S21_STATS.
+  std::vector<AlgorithmStats> stats_;
 
   void ClearInput() {
     std::cout << "Wrong input" << std::endl;
@@ -66,11 +115,15 @@ class NavigatorInterface {
     std::string filename;
     std::cout << "Insert filename" << std::endl;
     std::cin >> filename;
-    if (CheckIfFileExists(filename)) {
+    if (!CheckIfFileExists(filename)) {
+      std::cout << "Wrong filename" << std::endl;
+      return;
+    }
+    try {
       graph_.LoadGraphFromFile(filename);
       std::cout << "Success" << std::endl;
-    } else {
-      std::cout << "Wrong filename" << std::endl;
+    } catch (const std::exception &) {
+      std::cout << "Wrong weights" << std::endl;
     }
   }
 
@@ -125,9 +178,10 @@ class NavigatorInterface {
 
   void PrintGraph(std::vector<std::vector<int>> g) {
     size_t size = graph_.GetVertices();
+    BufferedWriter writer(std::cout);
     for (size_t i = 0; i < size; i++) {
-      for (size_t j = 0; j < size; j++) std::cout << g[i][j] << " ";
-      std::cout << std::endl;
+      for (size_t j = 0; j < size; j++) writer << g[i][j] << ' ';
+      writer << '\n';
     }
   }
 
@@ -145,6 +199,10 @@ class NavigatorInterface {
 
   void SolveSalesmanProblem() {
     TsmResult result = algorithms_.SolveTravelingSalesmanProblem(graph_);
+    if (result.vertices.empty()) {
+      std::cout << "Impossible: no tour visits every vertex" << std::endl;
+      return;
+    }
     for (size_t i = 0; i < result.vertices.size() - 1; i++)
       std::cout << result.vertices[i] << " - ";
     std::cout << result.vertices.back() << std::endl;
@@ -160,6 +218,124 @@ class NavigatorInterface {
     return res;
   }
 
+  struct Record {
+    BufferedWriter &writer;
+    OutputFormat format;
+    const std::string &command;
+    const std::vector<std::string> &arguments;
+  };
+
+  static size_t GetArity(const std::string &command) {
+    if (command == "sp") return 2;
+    if (command == "load" || command == "bfs" || command == "dfs") return 1;
+    return 0;
+  }
+
+  static long long GetMicroseconds(
+      std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+  }
+
+  size_t ParseVertex(const std::string &argument) {
+    size_t vertex = 0, end = 0;
+    try {
+      vertex = std::stoul(argument, &end);
+    } catch (const std::exception &) {
+    }
+    if (end != argument.size() || vertex < 1 || vertex > graph_.GetVertices())
+      throw std::invalid_argument("invalid vertex " + argument);
+    return vertex;
+  }
+
+  void RunCommand(const Record &record) {
+    const std::string &command = record.command;
+    const std::vector<std::string> &arguments = record.arguments;
+    auto start = std::chrono::steady_clock::now();
+    stats_.clear();
+    try {
+      if (command == "load") {
+        if (!CheckIfFileExists(arguments[0]))
+          throw std::invalid_argument("no such file");
+        graph_.LoadGraphFromFile(arguments[0]);
+        WriteRecord(record, true, GetMicroseconds(start), graph_.GetVertices());
+        return;
+      }
+      if (command != "bfs" && command != "dfs" && command != "sp" &&
+          command != "apsp" && command != "mst" && command != "tsp")
+        throw std::invalid_argument("unknown command");
+      if (graph_.IsEmpty()) throw std::invalid_argument("empty graph");
+      if (command == "bfs" || command == "dfs") {
+        size_t vertex = ParseVertex(arguments[0]);
+        start = std::chrono::steady_clock::now();
+        std::vector<int> order;
+        if (command == "bfs") {
+          Queue<int> queue = algorithms_.BreadthFirstSearch(graph_, vertex);
+          for (; !queue.empty(); queue.pop()) order.push_back(queue.front());
+        } else {
+          Stack<int> stack = algorithms_.DepthFirstSearch(graph_, vertex);
+          for (; !stack.empty(); stack.pop()) order.push_back(stack.top());
+          std::reverse(order.begin(), order.end());
+        }
+        WriteRecord(record, true, GetMicroseconds(start), order);
+      } else if (command == "sp") {
+        size_t vertex1 = ParseVertex(arguments[0]),
+               vertex2 = ParseVertex(arguments[1]);
+        start = std::chrono::steady_clock::now();
+        int distance = algorithms_.GetShortestPathBetweenVertices(
+            graph_, vertex1, vertex2);
+        WriteRecord(record, true, GetMicroseconds(start), distance);
+      } else if (command == "apsp" || command == "mst") {
+        std::vector<std::vector<int>> matrix =
+            command == "apsp"
+                ? algorithms_.GetShortestPathsBetweenAllVertices(graph_)
+                : algorithms_.GetLeastSpanningTree(graph_);
+        WriteRecord(record, true, GetMicroseconds(start), matrix);
+      } else {
+        TsmResult result = algorithms_.SolveTravelingSalesmanProblem(graph_);
+        WriteRecord(record, true, GetMicroseconds(start), result);
+      }
+    } catch (const std::invalid_argument &error) {
+      WriteRecord(record, false, GetMicroseconds(start),
+                  std::string(error.what()));
+    } catch (const std::exception &) {
+      WriteRecord(record, false, GetMicroseconds(start),
+                  std::string("failed"));
+    }
+  }
+
+  template <typename Result>
+  void WriteRecord(const Record &record, bool ok, long long microseconds,
+                   const Result &result) {
+    BufferedWriter &writer = record.writer;
+    bool json = record.format == OutputFormat::kJson;
+    if (json) {
+      writer << "{\"command\":";
+      WriteValue(writer, json, record.command);
+      writer << ",\"arguments\":[";
+    } else {
+      writer << record.command << ',';
+    }
+    for (size_t i = 0; i < record.arguments.size(); i++) {
+      if (i > 0) writer << (json ? ',' : ' ');
+      WriteValue(writer, json, record.arguments[i]);
+    }
+    writer << (json ? "],\"status\":\"" : ",") << (ok ? "ok" : "error")
+           << (json ? "\",\"microseconds\":" : ",") << microseconds;
+    if (kStatsEnabled && json) {
+      writer << ",\"stats\":";
+      WriteValue(writer, json, stats_);
+    }
+    writer << (json ? ",\"result\":" : ",");
+    WriteValue(writer, json, result);
+    if (kStatsEnabled && !json) {
+      writer << ',';
+      WriteValue(writer, json, stats_);
+    }
+    writer << (json ? "}\n" : "\n");
+  }
+
   void PrintOptions() {
     std::cout << std::endl;
     std::cout << "1. Load the original graph from a file" << std::endl;
@@ -176,4 +352,5 @@ class NavigatorInterface {
     std::cout << "0. Exit" << std::endl;
   }
 };
-}  // namespace s21
\ No newline at end of file
+}  // namespace s21
+#endif  // SRC_S21_NAVIGATOR_INTERFACE_H_
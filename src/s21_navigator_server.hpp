@@ -0,0 +1,493 @@
+#ifndef SRC_S21_NAVIGATOR_SERVER_H_
+#define SRC_S21_NAVIGATOR_SERVER_H_
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "s21_graph_algorithms.hpp"
+#include "s21_output_format.hpp"
+#include "s21_thread_pool.hpp"
+
+namespace s21 {
+// Query daemon on a Unix domain socket. Every request is one line holding a
+// flat JSON object, for example
+//   {"id":1,"op":"load","graph":"city","file":"city.txt"}
+//   {"id":2,"op":"sp","graph":"city","from":1,"to":6}
+// Operations: load, unload, list, bfs and dfs ("vertex"), sp ("from", "to"),
+// apsp, mst and tsp. Each request gets one line back, {"id":...,"status":"ok",
+// "result":...} or {"id":...,"status":"error","error":"..."}. Requests are
+// served concurrently, so answers on one connection may come back out of
+// order and are matched by id.
+//
+// One epoll loop does all socket I/O and hands complete lines to a worker
+// pool. Loaded graphs keep their component index, all-pairs matrix and
+// spanning tree for as long as they stay loaded; the algorithms cache holds
+// the other results as space allows. Loading a graph under a taken name
+// swaps it in atomically: queries already running finish on the old graph.
+class NavigatorServer {
+ public:
+  explicit NavigatorServer(std::string socket_path,
+                           size_t threads = std::thread::hardware_concurrency(),
+                           size_t cache_bytes = size_t(256) << 20)
+      : socket_path_(std::move(socket_path)),
+        cache_bytes_(cache_bytes),
+        workers_(std::make_unique<ThreadPool>(threads)),
+        stop_(false),
+        next_connection_(0) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_path_.size() >= sizeof(address.sun_path))
+      throw std::invalid_argument("socket path is too long");
+    std::strcpy(address.sun_path, socket_path_.c_str());
+    listener_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listener_ < 0) throw std::runtime_error("cannot create socket");
+    unlink(socket_path_.c_str());
+    if (bind(listener_, reinterpret_cast<sockaddr *>(&address),
+             sizeof(address)) < 0 ||
+        listen(listener_, SOMAXCONN) < 0) {
+      close(listener_);
+      throw std::runtime_error("cannot listen on " + socket_path_);
+    }
+    epoll_ = epoll_create1(EPOLL_CLOEXEC);
+    wakeup_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    Watch(listener_, EPOLLIN, kListener);
+    Watch(wakeup_, EPOLLIN, kWakeup);
+  }
+
+  NavigatorServer(const NavigatorServer &) = delete;
+  NavigatorServer &operator=(const NavigatorServer &) = delete;
+
+  // Requests still queued are answered into the void before the sockets
+  // are closed.
+  ~NavigatorServer() {
+    workers_.reset();
+    for (auto &connection : connections_) close(connection.second.fd);
+    close(wakeup_);
+    close(epoll_);
+    close(listener_);
+    unlink(socket_path_.c_str());
+  }
+
+  // Loads (or replaces) a named graph outside the request loop.
+  void LoadGraph(const std::string &name, const std::string &filename) {
+    std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+    std::ifstream file(filename);
+    if (!file.good()) throw std::invalid_argument("no such file");
+    entry->graph.LoadGraphFromFile(filename);
+    if (entry->graph.GetVertices() < 2)
+      throw std::invalid_argument("empty graph");
+    entry->algorithms.EnableCache(cache_bytes_);
+    entry->graph.GetComponentCount();
+    entry->all_paths =
+        entry->algorithms.GetSharedShortestPathsBetweenAllVertices(
+            entry->graph);
+    entry->spanning_tree =
+        entry->algorithms.GetSharedLeastSpanningTree(entry->graph);
+    std::lock_guard<std::mutex> lock(graphs_mutex_);
+    graphs_[name] = std::move(entry);
+  }
+
+  // Serves requests until Stop is called.
+  void Run() {
+    std::vector<epoll_event> events(64);
+    while (!stop_) {
+      int count = epoll_wait(epoll_, events.data(), events.size(), -1);
+      if (count < 0 && errno != EINTR) break;
+      for (int i = 0; i < count; i++) {
+        uint64_t id = events[i].data.u64;
+        if (id == kListener)
+          Accept();
+        else if (id == kWakeup)
+          Deliver();
+        else
+          Serve(id, events[i].events);
+      }
+    }
+  }
+
+  // Safe to call from any thread, including request handlers.
+  void Stop() {
+    stop_ = true;
+    uint64_t one = 1;
+    ssize_t written = write(wakeup_, &one, sizeof(one));
+    (void)written;
+  }
+
+ private:
+  // A loaded graph never changes, so the matrices computed at load time stay
+  // valid for the life of the entry.
+  struct Entry {
+    Graph graph;
+    GraphAlgorithms algorithms;
+    std::shared_ptr<const std::vector<std::vector<int>>> all_paths;
+    std::shared_ptr<const std::vector<std::vector<int>>> spanning_tree;
+  };
+
+  // A connection whose peer has stopped sending stays open until the
+  // answers to its pending requests are written out. While it only waits for
+  // workers it is taken out of epoll, which would otherwise keep reporting
+  // the hang-up.
+  struct Connection {
+    int fd;
+    std::string input, output;
+    size_t pending;
+    bool closed;
+    bool watched;
+  };
+
+  // A request field; text tells a JSON string from a number or literal.
+  struct Field {
+    std::string value;
+    bool text;
+  };
+
+  using Request = std::map<std::string, Field>;
+
+  static constexpr uint64_t kListener = ~uint64_t(0);
+  static constexpr uint64_t kWakeup = ~uint64_t(0) - 1;
+
+  const std::string socket_path_;
+  const size_t cache_bytes_;
+  std::unique_ptr<ThreadPool> workers_;
+  std::atomic<bool> stop_;
+  int listener_, epoll_, wakeup_;
+  uint64_t next_connection_;
+  std::unordered_map<uint64_t, Connection> connections_;
+  std::mutex graphs_mutex_;
+  std::map<std::string, std::shared_ptr<Entry>> graphs_;
+  std::mutex done_mutex_;
+  std::vector<std::pair<uint64_t, std::string>> done_;
+
+  void Watch(int fd, uint32_t events, uint64_t id) {
+    epoll_event event{};
+    event.events = events;
+    event.data.u64 = id;
+    epoll_ctl(epoll_, EPOLL_CTL_ADD, fd, &event);
+  }
+
+  void Accept() {
+    int fd;
+    while ((fd = accept4(listener_, nullptr, nullptr,
+                         SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+      uint64_t id = next_connection_++;
+      connections_[id] = Connection{fd, "", "", 0, false, true};
+      Watch(fd, EPOLLIN | EPOLLRDHUP, id);
+    }
+  }
+
+  void Serve(uint64_t id, uint32_t events) {
+    auto found = connections_.find(id);
+    if (found == connections_.end()) return;
+    Connection &connection = found->second;
+    if (!connection.closed &&
+        (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))) {
+      char buffer[1 << 16];
+      ssize_t size;
+      while ((size = read(connection.fd, buffer, sizeof(buffer))) > 0)
+        connection.input.append(buffer, size);
+      for (size_t end;
+           (end = connection.input.find('\n')) != std::string::npos;
+           connection.input.erase(0, end + 1)) {
+        std::string line = connection.input.substr(0, end);
+        connection.pending++;
+        workers_->Submit(
+            [this, id, line](size_t) { Complete(id, Handle(line)); });
+      }
+      if (size < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+        Drop(id);
+        return;
+      }
+      connection.closed = size == 0;
+    }
+    Send(id, connection);
+  }
+
+  void Complete(uint64_t id, std::string response) {
+    {
+      std::lock_guard<std::mutex> lock(done_mutex_);
+      done_.emplace_back(id, std::move(response));
+    }
+    uint64_t one = 1;
+    ssize_t written = write(wakeup_, &one, sizeof(one));
+    (void)written;
+  }
+
+  // Moves finished responses to their connections; answers for connections
+  // dropped in the meantime are discarded.
+  void Deliver() {
+    uint64_t counter;
+    ssize_t size = read(wakeup_, &counter, sizeof(counter));
+    (void)size;
+    std::vector<std::pair<uint64_t, std::string>> done;
+    {
+      std::lock_guard<std::mutex> lock(done_mutex_);
+      done.swap(done_);
+    }
+    for (std::pair<uint64_t, std::string> &response : done) {
+      auto found = connections_.find(response.first);
+      if (found == connections_.end()) continue;
+      found->second.pending--;
+      found->second.output += response.second;
+      Send(response.first, found->second);
+    }
+  }
+
+  // Writes as much output as the socket takes and waits for EPOLLOUT if
+  // anything is left. A closed connection is watched only for EPOLLOUT; if a
+  // fully closed peer makes that fire, the next send fails and drops it.
+  void Send(uint64_t id, Connection &connection) {
+    while (!connection.output.empty()) {
+      ssize_t size = send(connection.fd, connection.output.data(),
+                          connection.output.size(), MSG_NOSIGNAL);
+      if (size < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+        Drop(id);
+        return;
+      }
+      if (size <= 0) break;
+      connection.output.erase(0, size);
+    }
+    if (connection.closed && connection.pending == 0 &&
+        connection.output.empty()) {
+      Drop(id);
+      return;
+    }
+    epoll_event event{};
+    event.events = connection.closed ? 0 : EPOLLIN | EPOLLRDHUP;
+    if (!connection.output.empty()) event.events |= EPOLLOUT;
+    event.data.u64 = id;
+    if (event.events == 0) {
+      if (connection.watched)
+        epoll_ctl(epoll_, EPOLL_CTL_DEL, connection.fd, nullptr);
+      connection.watched = false;
+      return;
+    }
+    epoll_ctl(epoll_, connection.watched ? EPOLL_CTL_MOD : EPOLL_CTL_ADD,
+              connection.fd, &event);
+    connection.watched = true;
+  }
+
+  void Drop(uint64_t id) {
+    auto found = connections_.find(id);
+    if (found->second.watched)
+      epoll_ctl(epoll_, EPOLL_CTL_DEL, found->second.fd, nullptr);
+    close(found->second.fd);
+    connections_.erase(found);
+  }
+
+  // Parses a flat JSON object whose members are strings, numbers or
+  // literals, with nothing but white space after it. Anything else fails the
+  // parse, so non-string values can be echoed back verbatim.
+  static bool Parse(const std::string &line, Request &request) {
+    size_t i = 0;
+    auto space = [&] {
+      return std::isspace(static_cast<unsigned char>(line[i])) != 0;
+    };
+    auto skip = [&] {
+      while (i < line.size() && space()) i++;
+    };
+    auto string = [&](std::string &value) {
+      if (i >= line.size() || line[i] != '"') return false;
+      for (i++; i < line.size() && line[i] != '"'; i++) {
+        if (line[i] == '\\' && ++i == line.size()) return false;
+        value += line[i];
+      }
+      return i++ < line.size();
+    };
+    skip();
+    if (i >= line.size() || line[i++] != '{') return false;
+    skip();
+    bool empty = i < line.size() && line[i] == '}';
+    while (!empty) {
+      std::string key;
+      Field field{"", false};
+      if (!string(key)) return false;
+      skip();
+      if (i >= line.size() || line[i++] != ':') return false;
+      skip();
+      if (i < line.size() && line[i] == '"') {
+        if (!string(field.value)) return false;
+        field.text = true;
+      } else {
+        while (i < line.size() && line[i] != ',' && line[i] != '}' &&
+               !space())
+          field.value += line[i++];
+        if (!IsScalar(field.value)) return false;
+      }
+      request[key] = field;
+      skip();
+      if (i >= line.size() || (line[i] != ',' && line[i] != '}')) return false;
+      if (line[i] == '}') break;
+      i++;
+      skip();
+    }
+    i++;
+    skip();
+    return i == line.size();
+  }
+
+  // A JSON number, true, false or null.
+  static bool IsScalar(const std::string &value) {
+    if (value == "true" || value == "false" || value == "null") return true;
+    size_t i = value[0] == '-' ? 1 : 0;
+    auto digits = [&] {
+      size_t start = i;
+      while (i < value.size() && value[i] >= '0' && value[i] <= '9') i++;
+      return i > start;
+    };
+    if (i < value.size() && value[i] == '0')
+      i++;
+    else if (!digits())
+      return false;
+    if (i < value.size() && value[i] == '.' && (++i, !digits())) return false;
+    if (i < value.size() && (value[i] == 'e' || value[i] == 'E')) {
+      i++;
+      if (i < value.size() && (value[i] == '+' || value[i] == '-')) i++;
+      if (!digits()) return false;
+    }
+    return i == value.size();
+  }
+
+  static const Field &GetField(const Request &request,
+                               const std::string &key) {
+    auto found = request.find(key);
+    if (found == request.end())
+      throw std::invalid_argument("missing " + key);
+    return found->second;
+  }
+
+  static const std::string &Get(const Request &request,
+                                const std::string &key) {
+    return GetField(request, key).value;
+  }
+
+  // Vertices are JSON numbers; "1" is a string and is rejected.
+  static size_t GetVertex(const Request &request, const std::string &key,
+                          const Graph &graph) {
+    const Field &field = GetField(request, key);
+    if (field.text) throw std::invalid_argument("invalid " + key);
+    const std::string &value = field.value;
+    size_t vertex = 0, end = 0;
+    try {
+      vertex = std::stoul(value, &end);
+    } catch (const std::exception &) {
+    }
+    if (end != value.size() || vertex < 1 || vertex > graph.GetVertices())
+      throw std::invalid_argument("invalid " + key);
+    return vertex;
+  }
+
+  std::shared_ptr<Entry> Find(const Request &request) {
+    const std::string &name = Get(request, "graph");
+    std::lock_guard<std::mutex> lock(graphs_mutex_);
+    auto found = graphs_.find(name);
+    if (found == graphs_.end()) throw std::invalid_argument("unknown graph");
+    return found->second;
+  }
+
+  // Answers one request line. The result is written to a separate buffer so
+  // that a failure half way leaves no partial output behind.
+  std::string Handle(const std::string &line) {
+    Request request;
+    bool valid = Parse(line, request);
+    std::ostringstream result, response;
+    std::string error;
+    try {
+      if (!valid) throw std::invalid_argument("malformed request");
+      BufferedWriter writer(result, 1 << 12);
+      Answer(Get(request, "op"), request, writer);
+    } catch (const std::invalid_argument &failure) {
+      error = failure.what();
+    } catch (const std::exception &) {
+      error = "invalid request";
+    }
+    {
+      BufferedWriter writer(response, 1 << 12);
+      auto id = request.find("id");
+      writer << "{\"id\":";
+      if (id == request.end())
+        writer << "null";
+      else if (id->second.text)
+        WriteValue(writer, true, id->second.value);
+      else
+        writer << id->second.value;
+      if (error.empty()) {
+        writer << ",\"status\":\"ok\",\"result\":" << result.str();
+      } else {
+        writer << ",\"status\":\"error\",\"error\":";
+        WriteValue(writer, true, error);
+      }
+      writer << "}\n";
+    }
+    return response.str();
+  }
+
+  void Answer(const std::string &op, const Request &request,
+              BufferedWriter &writer) {
+    if (op == "load") {
+      LoadGraph(Get(request, "graph"), Get(request, "file"));
+      writer << Find(request)->graph.GetVertices();
+    } else if (op == "unload") {
+      Find(request);
+      std::lock_guard<std::mutex> lock(graphs_mutex_);
+      graphs_.erase(Get(request, "graph"));
+      writer << "true";
+    } else if (op == "list") {
+      std::vector<std::string> names;
+      {
+        std::lock_guard<std::mutex> lock(graphs_mutex_);
+        for (const auto &graph : graphs_) names.push_back(graph.first);
+      }
+      WriteValue(writer, true, names);
+    } else {
+      std::shared_ptr<Entry> entry = Find(request);
+      Graph &graph = entry->graph;
+      GraphAlgorithms &algorithms = entry->algorithms;
+      if (op == "bfs" || op == "dfs") {
+        size_t vertex = GetVertex(request, "vertex", graph);
+        std::vector<int> order;
+        if (op == "bfs") {
+          Queue<int> queue = algorithms.BreadthFirstSearch(graph, vertex);
+          for (; !queue.empty(); queue.pop()) order.push_back(queue.front());
+        } else {
+          Stack<int> stack = algorithms.DepthFirstSearch(graph, vertex);
+          for (; !stack.empty(); stack.pop()) order.push_back(stack.top());
+          std::reverse(order.begin(), order.end());
+        }
+        WriteValue(writer, true, order);
+      } else if (op == "sp") {
+        writer << algorithms.GetShortestPathBetweenVertices(
+            graph, GetVertex(request, "from", graph),
+            GetVertex(request, "to", graph));
+      } else if (op == "apsp") {
+        WriteValue(writer, true, *entry->all_paths);
+      } else if (op == "mst") {
+        WriteValue(writer, true, *entry->spanning_tree);
+      } else if (op == "tsp") {
+        WriteValue(writer, true,
+                   algorithms.SolveTravelingSalesmanProblem(graph));
+      } else {
+        throw std::invalid_argument("unknown op");
+      }
+    }
+  }
+};
+}  // namespace s21
+#endif  // SRC_S21_NAVIGATOR_SERVER_H_
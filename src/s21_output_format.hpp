@@ -0,0 +1,93 @@
+#ifndef SRC_S21_OUTPUT_FORMAT_H_
+#define SRC_S21_OUTPUT_FORMAT_H_
+#include <cmath>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_algorithm_stats.hpp"
+#include "s21_ant_colony.hpp"
+#include "s21_buffered_writer.hpp"
+
+namespace s21 {
+// Result values as written by the batch mode and the query server, either as
+// JSON or as a CSV field. CSV values never contain commas: sequences are
+// space separated and matrix rows are separated by semicolons.
+template <typename V>
+void WriteValue(BufferedWriter &writer, bool, V value) {
+  writer << value;
+}
+
+inline void WriteValue(BufferedWriter &writer, bool json,
+                       const std::string &text) {
+  if (!json) {
+    for (char symbol : text) writer << (symbol == ',' ? ' ' : symbol);
+    return;
+  }
+  writer << '"';
+  for (char symbol : text) {
+    if (symbol == '"' || symbol == '\\') writer << '\\';
+    writer << symbol;
+  }
+  writer << '"';
+}
+
+template <typename V>
+void WriteValue(BufferedWriter &writer, bool json,
+                const std::vector<V> &values) {
+  constexpr bool kMatrix = !std::is_arithmetic_v<V>;
+  if (json) writer << '[';
+  for (size_t i = 0; i < values.size(); i++) {
+    if (i > 0) writer << (json ? ',' : kMatrix ? ';' : ' ');
+    WriteValue(writer, json, values[i]);
+  }
+  if (json) writer << ']';
+}
+
+inline void WriteValue(BufferedWriter &writer, bool json,
+                       const TsmResult &result) {
+  if (json) {
+    writer << "{\"distance\":";
+    if (std::isinf(result.distance))
+      writer << "null";
+    else
+      writer << result.distance;
+    writer << ",\"vertices\":";
+  } else {
+    writer << result.distance << ';';
+  }
+  WriteValue(writer, json, result.vertices);
+  if (json) writer << '}';
+}
+
+// JSON gets every field; CSV gets the algorithm name followed by the
+// non-zero fields as key=value.
+inline void WriteValue(BufferedWriter &writer, bool json,
+                       const AlgorithmStats &stats) {
+  std::pair<const char *, double> fields[] = {
+      {"microseconds", stats.microseconds},
+      {"vertices_settled", stats.vertices_settled},
+      {"edges_relaxed", stats.edges_relaxed},
+      {"relaxations", stats.relaxations},
+      {"ant_steps", stats.ant_steps},
+      {"dead_ends", stats.dead_ends},
+      {"iterations_to_best", stats.iterations_to_best},
+      {"pheromone_entropy", stats.pheromone_entropy},
+      {"parse_microseconds", stats.parse_microseconds},
+      {"load_microseconds", stats.load_microseconds}};
+  if (json) {
+    writer << "{\"algorithm\":";
+    WriteValue(writer, json, std::string(stats.algorithm));
+    for (const auto &field : fields)
+      writer << ",\"" << field.first << "\":" << field.second;
+    writer << '}';
+    return;
+  }
+  writer << stats.algorithm;
+  for (const auto &field : fields)
+    if (field.second != 0)
+      writer << ' ' << field.first << '=' << field.second;
+}
+}  // namespace s21
+#endif  // SRC_S21_OUTPUT_FORMAT_H_
@@ -0,0 +1,165 @@
+#ifndef SRC_S21_QUERY_CACHE_H_
+#define SRC_S21_QUERY_CACHE_H_
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace s21 {
+struct CacheKey {
+  uint64_t version;
+  int kind;
+  size_t first;
+  size_t second;
+
+  bool operator==(const CacheKey &other) const {
+    return version == other.version && kind == other.kind &&
+           first == other.first && second == other.second;
+  }
+};
+
+struct CacheStats {
+  size_t hits = 0;
+  size_t misses = 0;
+  size_t evictions = 0;
+  size_t entries = 0;
+  size_t bytes = 0;
+};
+
+// Bounded LRU split into independently locked shards. Each entry is charged
+// the size passed to Insert against one budget shared by all shards, so an
+// entry is cached as long as it fits the whole budget. Over budget, the least
+// recently used entries go first within a shard, taking the shards in turn.
+// Keys carry the graph version, so stale entries are never matched and
+// simply age out.
+template <typename Value>
+class QueryCache {
+ public:
+  explicit QueryCache(size_t capacity_bytes, size_t shards = 16)
+      : shards_(std::max<size_t>(shards, 1)),
+        capacity_(capacity_bytes),
+        bytes_(0),
+        next_victim_(0),
+        hits_(0),
+        misses_(0),
+        evictions_(0) {}
+
+  std::shared_ptr<const Value> Find(const CacheKey &key) {
+    Shard &shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto found = shard.index.find(key);
+    if (found == shard.index.end()) {
+      misses_++;
+      return nullptr;
+    }
+    hits_++;
+    shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+    return found->second->value;
+  }
+
+  void Insert(const CacheKey &key, std::shared_ptr<const Value> value,
+              size_t bytes) {
+    if (bytes > capacity_) return;
+    {
+      Shard &shard = GetShard(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto found = shard.index.find(key);
+      if (found != shard.index.end()) Erase(shard, found->second);
+      shard.entries.push_front(Entry{key, std::move(value), bytes});
+      shard.index[key] = shard.entries.begin();
+      shard.bytes += bytes;
+      bytes_ += bytes;
+    }
+    Trim(key);
+  }
+
+  void Clear() {
+    for (Shard &shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      bytes_ -= shard.bytes;
+      shard.entries.clear();
+      shard.index.clear();
+      shard.bytes = 0;
+    }
+  }
+
+  CacheStats GetStats() {
+    CacheStats stats;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.evictions = evictions_;
+    for (Shard &shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      stats.entries += shard.entries.size();
+      stats.bytes += shard.bytes;
+    }
+    return stats;
+  }
+
+ private:
+  struct KeyHash {
+    size_t operator()(const CacheKey &key) const {
+      size_t hash = std::hash<uint64_t>()(key.version);
+      for (size_t part : {size_t(key.kind), key.first, key.second})
+        hash ^= std::hash<size_t>()(part) + 0x9e3779b97f4a7c15 + (hash << 6) +
+                (hash >> 2);
+      return hash;
+    }
+  };
+
+  struct Entry {
+    CacheKey key;
+    std::shared_ptr<const Value> value;
+    size_t bytes;
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    std::list<Entry> entries;
+    std::unordered_map<CacheKey, typename std::list<Entry>::iterator, KeyHash>
+        index;
+    size_t bytes = 0;
+  };
+
+  std::vector<Shard> shards_;
+  const size_t capacity_;
+  std::atomic<size_t> bytes_, next_victim_;
+  std::atomic<size_t> hits_, misses_, evictions_;
+
+  Shard &GetShard(const CacheKey &key) {
+    return shards_[KeyHash()(key) % shards_.size()];
+  }
+
+  void Erase(Shard &shard, typename std::list<Entry>::iterator entry) {
+    shard.bytes -= entry->bytes;
+    bytes_ -= entry->bytes;
+    shard.index.erase(entry->key);
+    shard.entries.erase(entry);
+  }
+
+  // Evicts one entry at a time, holding one shard lock at a time, until the
+  // cache is back within budget. The entry just inserted under kept is
+  // spared; a full round over the shards without a victim ends the loop.
+  void Trim(const CacheKey &kept) {
+    size_t idle = 0;
+    while (bytes_ > capacity_ && idle < shards_.size()) {
+      Shard &shard = shards_[next_victim_++ % shards_.size()];
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      if (shard.entries.empty() || shard.entries.back().key == kept) {
+        idle++;
+        continue;
+      }
+      Erase(shard, std::prev(shard.entries.end()));
+      evictions_++;
+      idle = 0;
+    }
+  }
+};
+}  // namespace s21
+#endif  // SRC_S21_QUERY_CACHE_H_
@@ -0,0 +1,63 @@
+#ifndef SRC_S21_TASK_CONTROL_H_
+#define SRC_S21_TASK_CONTROL_H_
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace s21 {
+// Thrown by an algorithm that was cancelled before it had a usable result.
+class OperationCancelled : public std::exception {
+ public:
+  const char *what() const noexcept override { return "operation cancelled"; }
+};
+
+// Flag shared between the caller and a running algorithm; copies refer to
+// the same flag.
+class CancellationToken {
+ public:
+  CancellationToken() : flag_(std::make_shared<std::atomic<bool>>(false)) {}
+
+  void Cancel() { flag_->store(true, std::memory_order_relaxed); }
+
+  bool IsCancelled() const { return flag_->load(std::memory_order_relaxed); }
+
+ private:
+  std::shared_ptr<std::atomic<bool>> flag_;
+
+  friend class TaskControl;
+};
+
+// Called with the steps done and the steps in total.
+using ProgressCallback = std::function<void(size_t, size_t)>;
+
+// What a long-running algorithm checks between its outer steps: whether to
+// stop, and whom to tell how far it got. The default one never cancels and
+// reports nowhere.
+class TaskControl {
+ public:
+  TaskControl() = default;
+
+  explicit TaskControl(const CancellationToken &token,
+                       ProgressCallback progress = nullptr)
+      : flag_(token.flag_), progress_(std::move(progress)) {}
+
+  explicit TaskControl(ProgressCallback progress)
+      : progress_(std::move(progress)) {}
+
+  bool IsCancelled() const {
+    return flag_ && flag_->load(std::memory_order_relaxed);
+  }
+
+  void Report(size_t done, size_t total) const {
+    if (progress_) progress_(done, total);
+  }
+
+ private:
+  std::shared_ptr<const std::atomic<bool>> flag_;
+  ProgressCallback progress_;
+};
+}  // namespace s21
+#endif  // SRC_S21_TASK_CONTROL_H_
@@ -0,0 +1,145 @@
+#ifndef SRC_S21_THREAD_POOL_H_
+#define SRC_S21_THREAD_POOL_H_
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+// Work-stealing pool: every worker owns a deque, takes its own tasks from the
+// back and steals from the front of the others when it runs dry. A task gets
+// the index of the worker running it, so callers can keep per-thread state.
+class ThreadPool {
+ public:
+  using Task = std::function<void(size_t)>;
+
+  explicit ThreadPool(size_t threads = std::thread::hardware_concurrency())
+      : queues_(std::max<size_t>(threads, 1)),
+        next_(0),
+        queued_(0),
+        stop_(false) {
+    for (size_t i = 0; i < queues_.size(); i++)
+      workers_.emplace_back([this, i] { Work(i); });
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &worker : workers_) worker.join();
+  }
+
+  // Pool shared by the algorithms; started on first use.
+  static ThreadPool &Shared() {
+    static ThreadPool pool;
+    return pool;
+  }
+
+  size_t GetThreads() const { return queues_.size(); }
+
+  void Submit(Task task) {
+    Queue &queue = queues_[next_++ % queues_.size()];
+    {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.tasks.push_back(std::move(task));
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queued_++;
+    }
+    wake_.notify_one();
+  }
+
+  // Runs task(worker, item) for every item in [0, count) and waits for all of
+  // them. If any item throws, the first exception is rethrown here once every
+  // item has finished. Must not be called from inside a pool task.
+  void ParallelFor(size_t count, std::function<void(size_t, size_t)> task) {
+    if (count == 0) return;
+    auto loop = std::make_shared<Loop>(count);
+    std::future<void> finished = loop->done.get_future();
+    for (size_t item = 0; item < count; item++)
+      Submit([task, item, loop](size_t worker) {
+        try {
+          task(worker, item);
+        } catch (...) {
+          if (!loop->failed.exchange(true))
+            loop->error = std::current_exception();
+        }
+        if (--loop->left > 0) return;
+        if (loop->error)
+          loop->done.set_exception(loop->error);
+        else
+          loop->done.set_value();
+      });
+    finished.get();
+  }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  // State shared by the items of one ParallelFor. error is written once, by
+  // the item that sets failed, and read by the last item to finish.
+  struct Loop {
+    explicit Loop(size_t count) : left(count), failed(false) {}
+    std::atomic<size_t> left;
+    std::atomic<bool> failed;
+    std::exception_ptr error;
+    std::promise<void> done;
+  };
+
+  std::vector<Queue> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<size_t> next_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  size_t queued_;
+  bool stop_;
+
+  bool Pop(size_t worker, Task &task) {
+    for (size_t i = 0; i < queues_.size(); i++) {
+      Queue &queue = queues_[(worker + i) % queues_.size()];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (queue.tasks.empty()) continue;
+      if (i == 0) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      } else {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+      return true;
+    }
+    return false;
+  }
+
+  void Work(size_t worker) {
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [this] { return stop_ || queued_ > 0; });
+        if (queued_ == 0) return;
+        queued_--;
+      }
+      Task task;
+      while (!Pop(worker, task)) std::this_thread::yield();
+      task(worker);
+    }
+  }
+};
+}  // namespace s21
+#endif  // SRC_S21_THREAD_POOL_H_
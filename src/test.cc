@@ -1,5 +1,10 @@
 #include "gtest/gtest.h"
+#include "s21_delta_stepping.hpp"
+#include "s21_dynamic_shortest_paths.hpp"
+#include "s21_dynamic_spanning_tree.hpp"
 #include "s21_graph_algorithms.hpp"
+#include "s21_navigator_interface.hpp"
+#include "s21_navigator_server.hpp"
 
 TEST(depth_first_search_test, s21_graph_algorithms) {
   s21::Graph g;
@@ -29,6 +34,24 @@ TEST(breadth_first_search_test, s21_graph_algorithms) {
   }
 }
 
+TEST(hop_distances_from_vertices, s21_graph_algorithms) {
+  s21::Graph g;
+  std::string filename = "../datasets/matrix_search.txt";
+  g.LoadGraphFromFile(filename);
+  s21::GraphAlgorithms a;
+  std::vector<size_t> sources;
+  for (size_t i = 0; i < 70; i++) sources.push_back(i % 7 + 1);
+  std::vector<std::vector<int>> result =
+      a.GetHopDistancesFromVertices(g, sources);
+  ASSERT_EQ(result.size(), sources.size());
+  ASSERT_EQ(result[4], std::vector<int>({2, 1, 2, 3, 0, 1, 2}));
+  ASSERT_EQ(result[69], std::vector<int>({4, 3, 4, 5, 2, 1, 0}));
+  g.LoadGraphFromFile("../datasets/matrix_wrong.txt");
+  result = a.GetHopDistancesFromVertices(g, {1});
+  ASSERT_EQ(result[0][5], std::numeric_limits<int>::max());
+  ASSERT_ANY_THROW(a.GetHopDistancesFromVertices(g, {7}));
+}
+
 TEST(shortest_path_two_vertices, s21_graph_algorithms) {
   s21::Graph g;
   std::string filename = "../datasets/matrix_shortests.txt";
@@ -38,6 +61,46 @@ TEST(shortest_path_two_vertices, s21_graph_algorithms) {
   ASSERT_EQ(result, 11);
 }
 
+TEST(shortest_paths_between_pairs, s21_graph_algorithms) {
+  s21::Graph g;
+  g.LoadGraphFromFile("../datasets/matrix_tsm.txt");
+  s21::GraphAlgorithms a;
+  std::vector<std::pair<size_t, size_t>> pairs;
+  for (size_t i = 1; i <= g.GetVertices(); i++)
+    for (size_t j = g.GetVertices(); j >= 1; j--) pairs.emplace_back(j, i);
+  std::vector<int> result = a.GetShortestPathsBetweenPairs(g, pairs);
+  ASSERT_EQ(result.size(), pairs.size());
+  for (size_t i = 0; i < pairs.size(); i++)
+    ASSERT_EQ(result[i], a.GetShortestPathBetweenVertices(g, pairs[i].first,
+                                                          pairs[i].second));
+  ASSERT_EQ(result[0], 18);
+  g.LoadGraphFromFile("../datasets/matrix_wrong.txt");
+  result = a.GetShortestPathsBetweenPairs(g, {{5, 1}, {1, 6}, {1, 5}});
+  ASSERT_EQ(result,
+            std::vector<int>({26, std::numeric_limits<int>::max(), 26}));
+  ASSERT_ANY_THROW(a.GetShortestPathsBetweenPairs(g, {{1, 7}}));
+}
+
+TEST(parallel_for, s21_thread_pool) {
+  s21::ThreadPool pool(4);
+  std::vector<size_t> workers(1000, pool.GetThreads());
+  std::atomic<size_t> sum = 0;
+  pool.ParallelFor(workers.size(), [&](size_t worker, size_t item) {
+    workers[item] = worker;
+    sum += item;
+  });
+  ASSERT_EQ(sum, 999u * 1000u / 2);
+  for (size_t worker : workers) ASSERT_LT(worker, pool.GetThreads());
+  sum = 0;
+  ASSERT_THROW(pool.ParallelFor(100,
+                                [&](size_t, size_t item) {
+                                  sum++;
+                                  if (item % 10 == 3) throw std::exception();
+                                }),
+               std::exception);
+  ASSERT_EQ(sum, 100u);
+}
+
 TEST(shortest_path_all_vertices, s21_graph_algorithms) {
   s21::Graph g;
   std::string filename = "../datasets/matrix_shortests.txt";
@@ -91,6 +154,280 @@ TEST(traveling_salesman_problem, s21_graph_algorithms) {
   ASSERT_DOUBLE_EQ(result.distance, INFINITY);
 }
 
+TEST(weight_types, s21_graph_algorithms) {
+  s21::Graph8 g8;
+  g8.LoadGraphFromFile("../datasets/matrix_tsm.txt");
+  ASSERT_EQ(g8.GetIndex(6, 8), 101);
+  s21::GraphAlgorithms8 a8;
+  uint32_t distance = a8.GetShortestPathBetweenVertices(g8, 7, 9);
+  ASSERT_EQ(distance, 101u);
+  std::vector<std::vector<uint8_t>> tree = a8.GetLeastSpanningTree(g8);
+  ASSERT_EQ(tree[1][6], 72);
+  std::ofstream file("fractional.txt");
+  file << "3\n0 0.5 2.5\n0.5 0 1.25\n2.5 1.25 0\n";
+  file.close();
+  s21::GraphF gf;
+  gf.LoadGraphFromFile("fractional.txt");
+  std::remove("fractional.txt");
+  ASSERT_TRUE(gf.GetWeighted());
+  s21::GraphAlgorithmsF af;
+  ASSERT_DOUBLE_EQ(af.GetShortestPathBetweenVertices(gf, 1, 3), 1.75);
+  ASSERT_DOUBLE_EQ(af.SolveTravelingSalesmanProblem(gf).distance, 4.25);
+  ASSERT_EQ(s21::WeightTraits<int>::Add(std::numeric_limits<int>::max() - 1, 5),
+            std::numeric_limits<int>::max());
+  file.open("narrow.txt");
+  file << "2\n0 300\n300 0\n";
+  file.close();
+  ASSERT_THROW(g8.LoadGraphFromFile("narrow.txt"), std::exception);
+  ASSERT_EQ(g8.GetIndex(6, 8), 101);
+  s21::Graph16 g16;
+  ASSERT_NO_THROW(g16.LoadGraphFromFile("narrow.txt"));
+  ASSERT_EQ(g16.GetIndex(0, 1), 300);
+  file.open("narrow.txt");
+  file << "2\n0 -1\n-1 0\n";
+  file.close();
+  ASSERT_THROW(g16.LoadGraphFromFile("narrow.txt"), std::exception);
+  ASSERT_THROW(gf.LoadGraphFromFile("narrow.txt"), std::exception);
+  std::remove("narrow.txt");
+}
+
+TEST(vertex_reordering, s21_graph_algorithms) {
+  s21::GraphAlgorithms a;
+  // Both traversals in visiting order, from every start vertex.
+  auto traverse = [&a](s21::Graph &graph) {
+    std::vector<int> res;
+    for (size_t start = 1; start <= graph.GetVertices(); start++) {
+      for (s21::Stack<int> depth = a.DepthFirstSearch(graph, start);
+           !depth.empty(); depth.pop())
+        res.push_back(depth.top());
+      for (s21::Queue<int> breadth = a.BreadthFirstSearch(graph, start);
+           !breadth.empty(); breadth.pop())
+        res.push_back(breadth.front());
+    }
+    return res;
+  };
+  s21::Graph plain;
+  plain.LoadGraphFromFile("../datasets/matrix_tsm.txt");
+  s21::Graph search;
+  search.LoadGraphFromFile("../datasets/matrix_search.txt");
+  for (s21::VertexOrder order :
+       {s21::VertexOrder::kBreadthFirst, s21::VertexOrder::kDegree,
+        s21::VertexOrder::kReverseCuthillMcKee}) {
+    s21::Graph g;
+    g.LoadGraphFromFile("../datasets/matrix_tsm.txt");
+    g.Reorder(order);
+    ASSERT_TRUE(g.IsReordered());
+    ASSERT_EQ(traverse(g), traverse(plain));
+    ASSERT_EQ(a.GetLeastSpanningTree(g), a.GetLeastSpanningTree(plain));
+    s21::Graph packed;
+    packed.LoadGraphFromFile("../datasets/matrix_search.txt");
+    packed.Reorder(order);
+    ASSERT_TRUE(packed.IsPacked());
+    ASSERT_EQ(traverse(packed), traverse(search));
+    ASSERT_EQ(a.GetLeastSpanningTree(packed), a.GetLeastSpanningTree(search));
+    for (size_t i = 0; i < g.GetVertices(); i++)
+      for (size_t j = 0; j < g.GetVertices(); j++)
+        ASSERT_EQ(g.GetIndex(g.GetInternalVertex(i), g.GetInternalVertex(j)),
+                  plain.GetIndex(i, j));
+    ASSERT_EQ(a.GetShortestPathsBetweenAllVertices(g),
+              a.GetShortestPathsBetweenAllVertices(plain));
+    int tree_weight = 0;
+    for (const std::vector<int> &row : a.GetLeastSpanningTree(g))
+      for (int weight : row) tree_weight += weight;
+    ASSERT_EQ(tree_weight, 2 * 150);
+    ASSERT_EQ(a.GetShortestPathBetweenVertices(g, 7, 9), 101);
+    s21::TsmResult tour = a.SolveTravelingSalesmanProblem(g);
+    ASSERT_EQ(tour.vertices.front(), 1);
+    ASSERT_EQ(tour.vertices.back(), 1);
+  }
+  s21::Graph g;
+  g.LoadGraphFromFile("../datasets/matrix_search.txt");
+  g.Reorder(s21::VertexOrder::kReverseCuthillMcKee);
+  ASSERT_TRUE(g.IsPacked());
+  s21::Queue<int> breadth = a.BreadthFirstSearch(g, 4);
+  ASSERT_EQ(breadth.front(), 4);
+  breadth.pop();
+  ASSERT_EQ(breadth.front(), 3);
+  ASSERT_EQ(a.GetHopDistancesFromVertices(g, {5})[0],
+            std::vector<int>({2, 1, 2, 3, 0, 1, 2}));
+}
+
+TEST(query_cache, s21_graph_algorithms) {
+  s21::Graph g;
+  g.LoadGraphFromFile("../datasets/matrix_tsm.txt");
+  s21::GraphAlgorithms a;
+  ASSERT_EQ(a.GetCacheStats().misses, 0u);
+  a.EnableCache(1 << 20);
+  std::vector<std::vector<int>> paths = a.GetShortestPathsBetweenAllVertices(g);
+  ASSERT_EQ(a.GetShortestPathsBetweenAllVertices(g), paths);
+  ASSERT_EQ(a.GetShortestPathBetweenVertices(g, 7, 9), 101);
+  ASSERT_EQ(a.GetShortestPathBetweenVertices(g, 7, 9), 101);
+  std::vector<int> tree = a.GetShortestPathsFromVertex(g, 7);
+  ASSERT_EQ(tree[8], 101);
+  ASSERT_EQ(a.GetShortestPathsBetweenPairs(g, {{7, 9}, {7, 7}}),
+            std::vector<int>({101, 0}));
+  auto spanning = a.GetSharedLeastSpanningTree(g);
+  ASSERT_EQ(a.GetSharedLeastSpanningTree(g), spanning);
+  ASSERT_EQ(a.GetLeastSpanningTree(g), *spanning);
+  ASSERT_EQ(*a.GetSharedShortestPathsBetweenAllVertices(g), paths);
+  s21::CacheStats stats = a.GetCacheStats();
+  ASSERT_EQ(stats.hits, 6u);
+  ASSERT_EQ(stats.misses, 4u);
+  ASSERT_EQ(stats.entries, 4u);
+  g.LoadGraphFromFile("../datasets/matrix_shortests.txt");
+  ASSERT_EQ(a.GetShortestPathBetweenVertices(g, 1, 6), 11);
+  ASSERT_EQ(a.GetCacheStats().misses, 5u);
+  ASSERT_EQ((*spanning)[1][6], 72);
+  s21::QueryCache<int> cache(100, 1);
+  for (size_t i = 0; i < 3; i++)
+    cache.Insert({1, 0, i, 0}, std::make_shared<const int>(i), 40);
+  ASSERT_EQ(cache.Find({1, 0, 0, 0}), nullptr);
+  ASSERT_EQ(*cache.Find({1, 0, 1, 0}), 1);
+  cache.Insert({1, 0, 3, 0}, std::make_shared<const int>(3), 40);
+  ASSERT_EQ(cache.Find({1, 0, 2, 0}), nullptr);
+  stats = cache.GetStats();
+  ASSERT_EQ(stats.evictions, 2u);
+  ASSERT_EQ(stats.bytes, 80u);
+  s21::QueryCache<int> sharded(100);
+  sharded.Insert({1, 0, 0, 0}, std::make_shared<const int>(0), 60);
+  ASSERT_EQ(*sharded.Find({1, 0, 0, 0}), 0);
+  sharded.Insert({1, 0, 1, 0}, std::make_shared<const int>(1), 60);
+  ASSERT_EQ(sharded.Find({1, 0, 0, 0}), nullptr);
+  ASSERT_EQ(*sharded.Find({1, 0, 1, 0}), 1);
+  stats = sharded.GetStats();
+  ASSERT_EQ(stats.entries, 1u);
+  ASSERT_EQ(stats.bytes, 60u);
+  // The all-pairs matrix is far larger than a sixteenth of the budget.
+  a.EnableCache(2000);
+  paths = a.GetShortestPathsBetweenAllVertices(g);
+  ASSERT_EQ(a.GetShortestPathsBetweenAllVertices(g), paths);
+  stats = a.GetCacheStats();
+  ASSERT_EQ(stats.hits, 1u);
+  ASSERT_EQ(stats.entries, 1u);
+  ASSERT_GT(stats.bytes, 2000u / 16);
+}
+
+TEST(edge_updates, s21_graph) {
+  s21::Graph g;
+  g.LoadGraphFromFile("../datasets/matrix_search.txt");
+  uint64_t version = g.GetVersion();
+  g.SetEdge(1, 7, 1);
+  ASSERT_TRUE(g.IsPacked());
+  ASSERT_EQ(g.GetEdge(7, 1), 1);
+  ASSERT_NE(g.GetVersion(), version);
+  g.SetEdge(1, 7, 5);
+  ASSERT_FALSE(g.IsPacked());
+  ASSERT_TRUE(g.GetWeighted());
+  ASSERT_EQ(g.GetIndex(6, 0), 5);
+  g.RemoveEdge(7, 1);
+  ASSERT_FALSE(g.GetWeighted());
+  ASSERT_FALSE(g.GetOriented());
+  ASSERT_EQ(g.GetEdge(1, 7), 0);
+  ASSERT_ANY_THROW(g.SetEdge(0, 1, 1));
+  ASSERT_ANY_THROW(g.SetEdge(1, 2, -1));
+  // An oriented graph whose edges become symmetric stays oriented.
+  std::ofstream file("oriented.txt");
+  file << "3\n0 5 0\n0 0 5\n0 0 0\n";
+  file.close();
+  g.LoadGraphFromFile("oriented.txt");
+  std::remove("oriented.txt");
+  g.SetEdge(2, 1, 5);
+  g.SetEdge(3, 2, 5);
+  ASSERT_TRUE(g.GetOriented());
+  g.RemoveEdge(1, 2);
+  ASSERT_EQ(g.GetEdge(1, 2), 0);
+  ASSERT_EQ(g.GetEdge(2, 1), 5);
+  ASSERT_TRUE(g.GetOriented());
+}
+
+TEST(dynamic_shortest_paths, s21_graph_algorithms) {
+  s21::GraphAlgorithms a;
+  std::ofstream file("oriented.txt");
+  file << "4\n0 5 0 0\n0 0 5 0\n0 0 0 5\n5 0 0 0\n";
+  file.close();
+  for (std::string filename : {"../datasets/matrix_tsm.txt", "oriented.txt"}) {
+    s21::Graph g;
+    g.LoadGraphFromFile(filename);
+    s21::DynamicShortestPaths paths(g);
+    std::mt19937 eng(21);
+    std::uniform_int_distribution<size_t> vertex(1, g.GetVertices());
+    std::uniform_int_distribution<int> weight(0, 30);
+    for (size_t step = 0; step < 200; step++) {
+      size_t from = vertex(eng), to = vertex(eng);
+      if (from == to) continue;
+      paths.SetEdge(from, to, weight(eng));
+      for (size_t i = 1; i <= g.GetVertices(); i++)
+        ASSERT_EQ(paths.GetDistances()[i - 1],
+                  a.GetShortestPathsFromVertex(g, i));
+    }
+    paths.RemoveEdge(1, 2);
+    ASSERT_EQ(g.GetEdge(1, 2), 0);
+  }
+  std::remove("oriented.txt");
+}
+
+TEST(dynamic_spanning_tree, s21_graph_algorithms) {
+  s21::GraphAlgorithms a;
+  s21::Graph g;
+  g.LoadGraphFromFile("../datasets/matrix_tsm.txt");
+  s21::DynamicSpanningTree tree(g);
+  ASSERT_EQ(tree.GetTotalWeight(), 150);
+  ASSERT_TRUE(tree.IsTreeEdge(2, 7));
+  tree.SetEdge(7, 5, 1);
+  ASSERT_FALSE(tree.IsTreeEdge(2, 7));
+  ASSERT_EQ(tree.GetTotalWeight(), 79);
+  std::mt19937 eng(21);
+  std::uniform_int_distribution<size_t> vertex(1, g.GetVertices());
+  std::uniform_int_distribution<int> weight(0, 40);
+  for (size_t step = 0; step < 300; step++) {
+    size_t from = vertex(eng), to = vertex(eng);
+    tree.SetEdge(from, to, weight(eng));
+    int expected = 0, actual = 0;
+    std::vector<std::vector<int>> prim = a.GetLeastSpanningTree(g),
+                                  current = tree.GetTree();
+    for (size_t i = 0; i < g.GetVertices(); i++)
+      for (size_t j = 0; j < g.GetVertices(); j++) {
+        expected += prim[i][j];
+        actual += current[i][j];
+        if (current[i][j] > 0) {
+          ASSERT_EQ(current[i][j], g.GetIndex(i, j));
+        }
+      }
+    ASSERT_EQ(actual, 2 * tree.GetTotalWeight());
+    ASSERT_EQ(actual, expected);
+  }
+}
+
+TEST(components, s21_graph) {
+  s21::Graph g;
+  g.LoadGraphFromFile("../datasets/matrix_wrong.txt");
+  ASSERT_EQ(g.GetComponentCount(), 2u);
+  ASSERT_EQ(g.GetComponentId(1), g.GetComponentId(5));
+  ASSERT_TRUE(g.IsUnreachable(1, 6));
+  ASSERT_FALSE(g.IsUnreachable(5, 2));
+  s21::GraphAlgorithms a;
+  ASSERT_TRUE(a.SolveTravelingSalesmanProblem(g).vertices.empty());
+  g.SetEdge(5, 6, 3);
+  ASSERT_EQ(g.GetComponentCount(), 1u);
+  ASSERT_EQ(a.GetShortestPathBetweenVertices(g, 1, 6), 29);
+  std::ofstream file("oriented.txt");
+  file << "5\n0 1 0 0 0\n0 0 1 0 0\n1 0 0 1 0\n0 0 0 0 1\n0 0 0 1 0\n";
+  file.close();
+  g.LoadGraphFromFile("oriented.txt");
+  std::remove("oriented.txt");
+  ASSERT_TRUE(g.GetOriented());
+  ASSERT_EQ(g.GetComponentCount(), 2u);
+  ASSERT_EQ(g.GetComponentId(1), g.GetComponentId(3));
+  ASSERT_EQ(g.GetComponentId(4), g.GetComponentId(5));
+  ASSERT_TRUE(g.IsUnreachable(4, 1));
+  ASSERT_FALSE(g.IsUnreachable(1, 5));
+  ASSERT_EQ(a.GetShortestPathBetweenVertices(g, 5, 2),
+            std::numeric_limits<int>::max());
+  ASSERT_EQ(a.GetShortestPathsBetweenPairs(g, {{5, 2}, {2, 5}}),
+            std::vector<int>({std::numeric_limits<int>::max(), 3}));
+  ASSERT_TRUE(a.SolveTravelingSalesmanProblem(g).vertices.empty());
+}
+
 TEST(exceptions, s21_graph_algorithms) {
   s21::Graph g;
   std::string filename = "";
@@ -152,6 +489,296 @@ TEST(export_to_dot, s21_graph) {
   file.close();
 }
 
+TEST(bit_matrix, s21_graph) {
+  s21::Graph g;
+  g.LoadGraphFromFile("../datasets/matrix_search.txt");
+  ASSERT_TRUE(g.IsPacked());
+  ASSERT_EQ(g.GetIndex(1, 4), 1);
+  ASSERT_EQ(g.GetIndex(1, 3), 0);
+  g.LoadGraphFromFile("../datasets/matrix_shortests.txt");
+  ASSERT_FALSE(g.IsPacked());
+  size_t size = 130;
+  std::ofstream file("cycle.txt");
+  file << size << std::endl;
+  for (size_t i = 0; i < size; i++) {
+    for (size_t j = 0; j < size; j++)
+      file << ((i + 1) % size == j || (j + 1) % size == i) << " ";
+    file << std::endl;
+  }
+  file.close();
+  g.LoadGraphFromFile("cycle.txt");
+  std::remove("cycle.txt");
+  ASSERT_TRUE(g.IsPacked());
+  ASSERT_EQ(g.GetNextNeighbor(64, 0), 63u);
+  ASSERT_EQ(g.GetNextNeighbor(64, 64), 65u);
+  ASSERT_EQ(g.GetComponentCount(), 1u);
+  s21::GraphAlgorithms a;
+  s21::Stack<int> depth = a.DepthFirstSearch(g, 1);
+  for (int i = size; i > 0; i--, depth.pop()) ASSERT_EQ(depth.top(), i);
+  s21::Queue<int> breadth = a.BreadthFirstSearch(g, 1);
+  ASSERT_EQ(breadth.size(), size);
+  breadth.pop();
+  ASSERT_EQ(breadth.front(), 2);
+  breadth.pop();
+  ASSERT_EQ(breadth.front(), 130);
+  ASSERT_DOUBLE_EQ(a.SolveTravelingSalesmanProblem(g).distance, 130);
+  file.open("late_weight.txt");
+  file << "3\n0 1 0\n1 0 1\n0 7 0\n";
+  file.close();
+  g.LoadGraphFromFile("late_weight.txt");
+  std::remove("late_weight.txt");
+  ASSERT_FALSE(g.IsPacked());
+  ASSERT_TRUE(g.GetWeighted());
+  ASSERT_TRUE(g.GetOriented());
+  ASSERT_EQ(g.GetIndex(0, 1), 1);
+  ASSERT_EQ(g.GetIndex(1, 2), 1);
+  ASSERT_EQ(g.GetIndex(2, 1), 7);
+}
+
+TEST(algorithm_stats, s21_graph_algorithms) {
+  std::vector<s21::AlgorithmStats> calls;
+  auto collect = [&calls](const s21::AlgorithmStats &stats) {
+    calls.push_back(stats);
+  };
+  s21::Graph g;
+  g.SetStatsCallback(collect);
+  g.LoadGraphFromFile("../datasets/matrix_tsm.txt");
+  s21::GraphAlgorithms a;
+  a.SetStatsCallback(collect);
+  a.GetShortestPathBetweenVertices(g, 1, 11);
+  a.GetShortestPathsBetweenAllVertices(g);
+  a.GetLeastSpanningTree(g);
+  a.SolveTravelingSalesmanProblem(g);
+  if (!s21::kStatsEnabled) {
+    ASSERT_TRUE(calls.empty());
+    ASSERT_TRUE(std::is_empty_v<s21::StatsSlot>);
+    return;
+  }
+  ASSERT_EQ(calls.size(), 5u);
+  ASSERT_STREQ(calls[0].algorithm, "LoadGraphFromFile");
+  ASSERT_GT(calls[0].load_microseconds, 0);
+  ASSERT_LE(calls[0].parse_microseconds, calls[0].load_microseconds);
+  ASSERT_GT(calls[1].vertices_settled, 0u);
+  ASSERT_GE(calls[1].edges_relaxed, calls[1].vertices_settled);
+  ASSERT_GT(calls[2].relaxations, 0u);
+  ASSERT_EQ(calls[3].vertices_settled, 11u);
+  ASSERT_STREQ(calls[4].algorithm, "SolveTravelingSalesmanProblem");
+  ASSERT_GT(calls[4].ant_steps, 0u);
+  ASSERT_GE(calls[4].iterations_to_best, 1u);
+  ASSERT_LE(calls[4].iterations_to_best, 100u);
+  ASSERT_GT(calls[4].pheromone_entropy, 0);
+  ASSERT_LT(calls[4].pheromone_entropy, 1);
+}
+
+TEST(async_algorithms, s21_graph_algorithms) {
+  s21::Graph g;
+  g.LoadGraphFromFile("../datasets/matrix_tsm.txt");
+  s21::GraphAlgorithms a;
+  std::vector<size_t> pivots;
+  std::future<std::vector<std::vector<int>>> paths =
+      a.GetShortestPathsBetweenAllVerticesAsync(
+          g, s21::TaskControl([&pivots](size_t done, size_t total) {
+            pivots.push_back(done);
+            ASSERT_EQ(total, 11u);
+          }));
+  ASSERT_EQ(paths.get(), a.GetShortestPathsBetweenAllVertices(g));
+  ASSERT_EQ(pivots.size(), 11u);
+  ASSERT_EQ(pivots.back(), 11u);
+
+  s21::CancellationToken cancelled;
+  cancelled.Cancel();
+  std::future<std::vector<std::vector<int>>> tree =
+      a.GetLeastSpanningTreeAsync(g, s21::TaskControl(cancelled));
+  ASSERT_THROW(tree.get(), s21::OperationCancelled);
+
+  // Stopped after five iterations, the tour found so far is still returned.
+  s21::CancellationToken token;
+  size_t iterations = 0;
+  std::future<s21::TsmResult> tour = a.SolveTravelingSalesmanProblemAsync(
+      g, s21::TaskControl(token, [&](size_t done, size_t) {
+        iterations = done;
+        if (done == 5) token.Cancel();
+      }));
+  s21::TsmResult result = tour.get();
+  ASSERT_EQ(iterations, 5u);
+  ASSERT_EQ(result.vertices.size(), 12u);
+  ASSERT_EQ(result.vertices.front(), 1);
+  ASSERT_EQ(result.vertices.back(), 1);
+  ASSERT_LT(result.distance, INFINITY);
+}
+
+TEST(delta_stepping, s21_delta_stepping) {
+  size_t size = 300;
+  std::mt19937 eng(21);
+  std::bernoulli_distribution edge(0.02);
+  std::uniform_int_distribution<int> weight(1, 20);
+  std::ofstream file("random.txt");
+  file << size << std::endl;
+  for (size_t i = 0; i < size; i++) {
+    for (size_t j = 0; j < size; j++)
+      file << (edge(eng) ? weight(eng) : 0) << ' ';
+    file << std::endl;
+  }
+  file.close();
+  s21::Graph g;
+  g.LoadGraphFromFile("random.txt");
+  std::remove("random.txt");
+  s21::GraphAlgorithms a;
+  for (int reordered = 0; reordered < 2; reordered++) {
+    if (reordered) g.Reorder(s21::VertexOrder::kReverseCuthillMcKee);
+    for (size_t threads : {1, 3}) {
+      s21::ThreadPool pool(threads);
+      for (int delta : {1, 5, 40}) {
+        s21::DeltaStepping search(g, delta);
+        for (size_t source : {1, 150}) {
+          s21::DeltaStepping::ShortestPathTree tree =
+              search.Search(source, pool);
+          ASSERT_EQ(tree.distances, a.GetShortestPathsFromVertex(g, source));
+          for (size_t v = 1; v <= size; v++) {
+            size_t parent = tree.parents[v - 1];
+            if (v == source ||
+                tree.distances[v - 1] == s21::WeightTraits<int>::Infinity()) {
+              ASSERT_EQ(parent, 0u);
+              continue;
+            }
+            ASSERT_EQ(tree.distances[parent - 1] + g.GetEdge(parent, v),
+                      tree.distances[v - 1]);
+          }
+        }
+      }
+    }
+  }
+  ASSERT_THROW(s21::DeltaStepping(g, 0), std::exception);
+  file.open("far.txt");
+  file << "3\n0 100000000 0\n0 0 1\n0 0 0\n";
+  file.close();
+  s21::Graph far;
+  far.LoadGraphFromFile("far.txt");
+  std::remove("far.txt");
+  s21::ThreadPool pool(2);
+  s21::DeltaStepping::ShortestPathTree tree =
+      s21::DeltaStepping(far, 1).Search(1, pool);
+  ASSERT_EQ(tree.distances, std::vector<int>({0, 100000000, 100000001}));
+  ASSERT_EQ(tree.parents, std::vector<size_t>({0, 1, 2}));
+}
+
+TEST(batch_mode, s21_navigator_interface) {
+  s21::NavigatorInterface n;
+  std::stringstream script(
+      "load ../datasets/matrix_search.txt\nbfs 5\ndfs 5 sp 1 7\n"
+      "sp 1 8 apsp jump"),
+      out;
+  n.RunBatch(script, out, s21::NavigatorInterface::OutputFormat::kCsv);
+  std::vector<std::string> expected = {
+      "command,arguments,status,result",
+      "load,../datasets/matrix_search.txt,ok,7",
+      "bfs,5,ok,5 2 6 1 3 7 4",
+      "dfs,5,ok,5 2 1 3 4 6 7",
+      "sp,1 7,ok,4",
+      "sp,1 8,error,invalid vertex 8",
+      "apsp,,ok,",
+      "jump,,error,unknown command"};
+  std::string line;
+  for (const std::string &answer : expected) {
+    std::getline(out, line);
+    size_t time = line.find(',', line.find(',', line.find(',') + 1) + 1);
+    line.erase(time, line.find(',', time + 1) - time);
+    ASSERT_EQ(line.substr(0, answer.size()), answer);
+  }
+  std::stringstream json_script("sp 2 5 tsp"), json;
+  n.RunBatch(json_script, json, s21::NavigatorInterface::OutputFormat::kJson);
+  std::getline(json, line);
+  ASSERT_EQ(line.substr(0, 51),
+            "{\"command\":\"sp\",\"arguments\":[\"2\",\"5\"],"
+            "\"status\":\"ok\"");
+  ASSERT_EQ(line.substr(line.size() - 11), "\"result\":1}");
+}
+
+TEST(query_server, s21_navigator_server) {
+  std::string path = "/tmp/s21_navigator_test.sock";
+  s21::NavigatorServer server(path, 2);
+  std::thread loop([&server] { server.Run(); });
+  int client = socket(AF_UNIX, SOCK_STREAM, 0);
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  std::strcpy(address.sun_path, path.c_str());
+  ASSERT_EQ(connect(client, reinterpret_cast<sockaddr *>(&address),
+                    sizeof(address)),
+            0);
+  std::string received;
+  auto ask = [&](const std::string &requests, size_t answers) {
+    ASSERT_EQ(write(client, requests.data(), requests.size()),
+              ssize_t(requests.size()));
+    char buffer[4096];
+    while (std::count(received.begin(), received.end(), '\n') <
+           ssize_t(answers)) {
+      ssize_t size = read(client, buffer, sizeof(buffer));
+      ASSERT_GT(size, 0);
+      received.append(buffer, size);
+    }
+  };
+  auto next = [&] {
+    size_t end = received.find('\n');
+    std::string line = received.substr(0, end);
+    received.erase(0, end + 1);
+    return line;
+  };
+  ask("{\"id\":1,\"op\":\"load\",\"graph\":\"city\","
+      "\"file\":\"../datasets/matrix_search.txt\"}\n",
+      1);
+  ASSERT_EQ(next(), "{\"id\":1,\"status\":\"ok\",\"result\":7}");
+  ask("{\"id\":2,\"op\":\"sp\",\"graph\":\"city\",\"from\":1,\"to\":7}\n",
+      1);
+  ASSERT_EQ(next(), "{\"id\":2,\"status\":\"ok\",\"result\":4}");
+  // A tour still running on the old graph is not disturbed by the swap.
+  ask("{\"id\":3,\"op\":\"tsp\",\"graph\":\"city\"}\n"
+      "{\"id\":4,\"op\":\"load\",\"graph\":\"city\","
+      "\"file\":\"../datasets/matrix_tsm.txt\"}\n",
+      2);
+  std::string first = next(), second = next();
+  if (first.find("\"id\":4") != std::string::npos) std::swap(first, second);
+  ASSERT_EQ(first.substr(0, 21), "{\"id\":3,\"status\":\"ok\"");
+  ASSERT_EQ(second, "{\"id\":4,\"status\":\"ok\",\"result\":11}");
+  ask("{\"id\":\"a\",\"op\":\"sp\",\"graph\":\"city\",\"from\":1,\"to\":12}\n"
+      "{\"id\":5,\"op\":\"list\"}\n",
+      2);
+  first = next();
+  second = next();
+  if (first.find("\"id\":5") != std::string::npos) std::swap(first, second);
+  ASSERT_EQ(first,
+            "{\"id\":\"a\",\"status\":\"error\",\"error\":\"invalid to\"}");
+  ASSERT_EQ(second, "{\"id\":5,\"status\":\"ok\",\"result\":[\"city\"]}");
+  ask("{\"op\":\"jump\"\n", 1);
+  ASSERT_EQ(next(),
+            "{\"id\":null,\"status\":\"error\",\"error\":"
+            "\"malformed request\"}");
+  ask("{\"id\":1\"x,\"op\":\"list\"}\n", 1);
+  ASSERT_EQ(next(),
+            "{\"id\":null,\"status\":\"error\",\"error\":"
+            "\"malformed request\"}");
+  ask("{\"id\":7 \"op\":\"list\"}\n", 1);
+  ASSERT_EQ(next(),
+            "{\"id\":7,\"status\":\"error\",\"error\":"
+            "\"malformed request\"}");
+  ask("{\"id\":8,\"op\":\"list\"}garbage\n", 1);
+  ASSERT_EQ(next(),
+            "{\"id\":8,\"status\":\"error\",\"error\":"
+            "\"malformed request\"}");
+  ask("{\"id\":9,\"op\":\"sp\",\"graph\":\"city\",\"from\":\"1\",\"to\":2}\n",
+      1);
+  ASSERT_EQ(next(),
+            "{\"id\":9,\"status\":\"error\",\"error\":\"invalid from\"}");
+  ask("{\"id\":-2.5e3,\"op\":\"list\"}\n", 1);
+  ASSERT_EQ(next(), "{\"id\":-2.5e3,\"status\":\"ok\",\"result\":[\"city\"]}");
+  ask("{\"id\":6,\"op\":\"mst\",\"graph\":\"city\"}\n", 1);
+  std::string tree = next();
+  ASSERT_EQ(tree.substr(0, 35), "{\"id\":6,\"status\":\"ok\",\"result\":[[0,");
+  ASSERT_EQ(std::count(tree.begin(), tree.end(), '['), 12);
+  close(client);
+  server.Stop();
+  loop.join();
+}
+
 int main() {
   testing::InitGoogleTest();
   return RUN_ALL_TESTS();